@@ -0,0 +1,528 @@
+// BasicGraph.h		Author: Sam Hoover
+// contains the declaration and definition of the BasicGraph class template
+// and its WeightTraits and PayloadStore helpers.
+//
+#ifndef BASICGRAPH_H
+#define BASICGRAPH_H
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// WeightTraits		Author: Sam Hoover
+//
+// Description:
+// The arithmetic BasicGraph needs from an edge weight type, Weight. Integer
+// weights, signed or unsigned, use the largest value as infinity and add
+// with saturation, so a path too long for Weight becomes "no path" instead
+// of wrapping around to a short one. Floating point weights use their own
+// infinity, which addition already saturates to.
+//
+// Assumptions:
+// This class assumes the following:
+//		-add(a, b) is only called with valid weights or distances
+//
+template <typename Weight, bool IsInteger = numeric_limits<Weight>::is_integer>
+struct WeightTraits {
+	// infinity
+	// returns the distance that stands for no path
+	// preconditions:	none
+	// postconditions:	returns numeric_limits<Weight>::infinity()
+	//
+	static Weight infinity() {
+		return(numeric_limits<Weight>::infinity());
+	}
+
+	// add
+	// returns a + b, or infinity() if the sum is too large to represent
+	// preconditions:	a and b are not negative
+	// postconditions:	returns the saturated sum
+	//
+	static Weight add(Weight a, Weight b) {
+		return(a + b);
+	}
+
+	// isValid
+	// returns true if weight can be the weight of an edge
+	// preconditions:	none
+	// postconditions:	returns true if 0 <= weight < infinity(); false for NaN
+	//
+	static bool isValid(Weight weight) {
+		return(weight >= Weight() && weight < infinity());
+	}
+};
+
+template <typename Weight>
+struct WeightTraits<Weight, true> {
+	// infinity
+	// returns the distance that stands for no path
+	// preconditions:	none
+	// postconditions:	returns numeric_limits<Weight>::max()
+	//
+	static Weight infinity() {
+		return(numeric_limits<Weight>::max());
+	}
+
+	// add
+	// returns a + b, or infinity() if the sum is too large to represent
+	// preconditions:	a and b are not negative
+	// postconditions:	returns the saturated sum
+	//
+	static Weight add(Weight a, Weight b) {
+		return(b >= infinity() - a ? infinity() : static_cast<Weight>(a + b));
+	}
+
+	// isValid
+	// returns true if weight can be the weight of an edge
+	// preconditions:	none
+	// postconditions:	returns true if 0 <= weight < infinity()
+	//
+	static bool isValid(Weight weight) {
+		return(!(weight < Weight()) && weight < infinity());
+	}
+};
+
+// NoPayload
+// the Payload of a BasicGraph whose vertices carry no data
+//
+struct NoPayload {};
+
+// PayloadStore		Author: Sam Hoover
+//
+// Description:
+// The data BasicGraph keeps for each vertex, stored by value in one array
+// instead of one heap allocation per vertex. PayloadStore<NoPayload> stores
+// nothing at all.
+//
+template <typename Payload>
+class PayloadStore {
+public:
+	// resize
+	// sets the number of vertices, default constructing any new payloads
+	// preconditions:	size >= 0
+	// postconditions:	m_payloads holds size payloads
+	//
+	void resize(int size) {
+		m_payloads.resize(size);
+	}
+
+	// get
+	// returns the payload of the vertex with index value index
+	// preconditions:	index is less than the size
+	// postconditions:	returns m_payloads[index]
+	//
+	const Payload &get(int index) const {
+		return(m_payloads[index]);
+	}
+
+	// set
+	// replaces the payload of the vertex with index value index
+	// preconditions:	index is less than the size
+	// postconditions:	m_payloads[index] = payload
+	//
+	void set(int index, const Payload &payload) {
+		m_payloads[index] = payload;
+	}
+
+private:
+	vector<Payload> m_payloads;
+};
+
+template <>
+class PayloadStore<NoPayload> {
+public:
+	// resize
+	// does nothing; there are no payloads to keep
+	// preconditions:	none
+	// postconditions:	none
+	//
+	void resize(int) {}
+
+	// get
+	// returns an empty NoPayload for every vertex
+	// preconditions:	none
+	// postconditions:	returns a NoPayload that lives as long as the program
+	//
+	const NoPayload &get(int) const {
+		static const NoPayload none = NoPayload();
+		return(none);
+	}
+
+	// set
+	// does nothing; there are no payloads to keep
+	// preconditions:	none
+	// postconditions:	none
+	//
+	void set(int, const NoPayload &) {}
+};
+
+// BasicGraph		Author: Sam Hoover
+//
+// Description:
+// A compact weighted graph whose edge weight type, Weight, and vertex data
+// type, Payload, are template parameters. It supports integer weights of
+// any width, signed or unsigned, and float or double weights, and either
+// stores a Payload by value for every vertex or, with NoPayload, stores no
+// vertex data at all. Each vertex's outgoing edges are kept in a vector of
+// (adjacent vertex, weight) pairs.
+//
+// Functionality:
+// A BasicGraph is created with a fixed number of vertices. Edges are added
+// with insertEdge(int, int, Weight), which replaces the weight of an edge
+// that already exists, and removed with removeEdge(int, int). Shortest paths
+// are found with Dijkstra's algorithm and a binary min-heap, either from one
+// source to every vertex, with findShortestPath(int, vector<Weight>&,
+// vector<int>&), or from one source to one destination, with query(int, int),
+// which stops once the destination is reached. Distances are summed with
+// WeightTraits<Weight>::add, so a path longer than Weight can hold reads as
+// no path instead of overflowing. As in Graph, vertices are settled in
+// (distance, index value) order and a predecessor is only replaced by a
+// strictly shorter path, so an int BasicGraph gives the same paths as Graph.
+// Vertices are given by numerical-order values, 1 through getSize().
+//
+// Graph keeps int weights and a GraphData title for every vertex, along with
+// its row cache, engines and file formats; BasicGraph is the smaller core to
+// use when another weight type, or no titles, are wanted.
+//
+// Assumptions:
+// This class assumes the following:
+//		-edge weights are not negative, not NaN and less than infinity()
+//
+template <typename Weight, typename Payload = NoPayload>
+class BasicGraph {
+public:
+	typedef WeightTraits<Weight> Traits;
+
+	// PathResult
+	// the answer to query(int, int). m_found is false when there is no path
+	// from source to dest, in which case m_dist is infinity() and m_path is
+	// empty. Otherwise m_dist is the length of the shortest path and m_path
+	// holds the numerical-order values of its vertices, from source to dest.
+	//
+	struct PathResult {
+		PathResult() : m_found(false), m_dist(Traits::infinity()) {}
+
+		bool m_found;
+		Weight m_dist;
+		vector<int> m_path;
+	};
+
+	// constructor(int)
+	// creates a BasicGraph with size vertices and no edges
+	// preconditions:	size >= 0
+	// postconditions:	m_edges holds size empty lists; every payload is
+	//					default constructed
+	//
+	explicit BasicGraph(int size = 0);
+
+	// infinity
+	// returns the distance that stands for no path
+	// preconditions:	none
+	// postconditions:	returns Traits::infinity()
+	//
+	static Weight infinity();
+
+	// getSize
+	// returns the number of vertices
+	// preconditions:	none
+	// postconditions:	returns the size of m_edges
+	//
+	int getSize() const;
+
+	// getEdgeCount
+	// returns the number of edges
+	// preconditions:	none
+	// postconditions:	returns m_edgeCount
+	//
+	int getEdgeCount() const;
+
+	// getPayload
+	// returns the data of vertex
+	// preconditions:	1 <= vertex <= getSize()
+	// postconditions:	returns vertex's payload
+	//
+	const Payload &getPayload(int vertex) const;
+
+	// setPayload
+	// replaces the data of vertex
+	// preconditions:	1 <= vertex <= getSize()
+	// postconditions:	vertex's payload = payload
+	//
+	void setPayload(int vertex, const Payload &payload);
+
+	// insertEdge
+	// inserts an edge from source to dest with weight cost, replacing the
+	// weight if the edge already exists. Does nothing if source or dest is
+	// not a vertex, they are the same vertex or cost is not a valid weight.
+	// preconditions:	none
+	// postconditions:	the edge source -> dest has weight cost
+	//
+	void insertEdge(int source, int dest, Weight cost);
+
+	// removeEdge
+	// removes the edge from source to dest, if there is one
+	// preconditions:	none
+	// postconditions:	there is no edge source -> dest
+	//
+	void removeEdge(int source, int dest);
+
+	// findShortestPath
+	// finds the shortest paths from source to every vertex. dist[v - 1] is
+	// set to the length of the shortest path to vertex v, or infinity() if
+	// there is none, and pred[v - 1] to the vertex before v on it, or 0 if
+	// v is source or there is no path.
+	// preconditions:	1 <= source <= getSize()
+	// postconditions:	dist and pred hold getSize() entries set as above
+	//
+	void findShortestPath(int source, vector<Weight> &dist, vector<int> &pred) const;
+
+	// query
+	// finds the shortest path from source to dest, searching only until dest
+	// is reached
+	// preconditions:	none
+	// postconditions:	returns the shortest path from source to dest, or a
+	//					PathResult with m_found = false if there is none
+	//
+	PathResult query(int source, int dest) const;
+
+private:
+	// Edge
+	// an outgoing edge to the vertex with index value m_adjVertex
+	//
+	struct Edge {
+		int m_adjVertex;
+		Weight m_weight;
+	};
+
+	// min-heap of (distance, vertex index) pairs with lazy deletion
+	typedef priority_queue<pair<Weight, int>, vector<pair<Weight, int> >,
+		greater<pair<Weight, int> > > MinHeap;
+
+	vector<vector<Edge> > m_edges;	// outgoing edges of each vertex
+	PayloadStore<Payload> m_payloads;
+	int m_edgeCount;
+
+	// search
+	// runs Dijkstra's algorithm from the vertex with index value source,
+	// stopping once the vertex with index value dest is settled, or at the
+	// end if dest is -1
+	// preconditions:	source is an index value
+	// postconditions:	dist and pred hold getSize() entries, by index
+	//					value; every settled vertex has its final distance
+	//					and its predecessor's index value, -1 for none
+	//
+	void search(int source, int dest, vector<Weight> &dist, vector<int> &pred) const;
+};
+
+// constructor(int)
+// creates a BasicGraph with size vertices and no edges
+// preconditions:	size >= 0
+// postconditions:	m_edges holds size empty lists; every payload is
+//					default constructed
+//
+template <typename Weight, typename Payload>
+BasicGraph<Weight, Payload>::BasicGraph(int size) : m_edges(size),
+	m_edgeCount(0) {
+	m_payloads.resize(size);
+}
+
+
+// infinity
+// returns the distance that stands for no path
+// preconditions:	none
+// postconditions:	returns Traits::infinity()
+//
+template <typename Weight, typename Payload>
+Weight BasicGraph<Weight, Payload>::infinity() {
+	return(Traits::infinity());
+}
+
+
+// getSize
+// returns the number of vertices
+// preconditions:	none
+// postconditions:	returns the size of m_edges
+//
+template <typename Weight, typename Payload>
+int BasicGraph<Weight, Payload>::getSize() const {
+	return(static_cast<int>(m_edges.size()));
+}
+
+
+// getEdgeCount
+// returns the number of edges
+// preconditions:	none
+// postconditions:	returns m_edgeCount
+//
+template <typename Weight, typename Payload>
+int BasicGraph<Weight, Payload>::getEdgeCount() const {
+	return(m_edgeCount);
+}
+
+
+// getPayload
+// returns the data of vertex
+// preconditions:	1 <= vertex <= getSize()
+// postconditions:	returns vertex's payload
+//
+template <typename Weight, typename Payload>
+const Payload &BasicGraph<Weight, Payload>::getPayload(int vertex) const {
+	return(m_payloads.get(vertex - 1));
+}
+
+
+// setPayload
+// replaces the data of vertex
+// preconditions:	1 <= vertex <= getSize()
+// postconditions:	vertex's payload = payload
+//
+template <typename Weight, typename Payload>
+void BasicGraph<Weight, Payload>::setPayload(int vertex, const Payload &payload) {
+	m_payloads.set(vertex - 1, payload);
+}
+
+
+// insertEdge
+// inserts an edge from source to dest with weight cost, replacing the
+// weight if the edge already exists. Does nothing if source or dest is
+// not a vertex, they are the same vertex or cost is not a valid weight.
+// preconditions:	none
+// postconditions:	the edge source -> dest has weight cost
+//
+template <typename Weight, typename Payload>
+void BasicGraph<Weight, Payload>::insertEdge(int source, int dest, Weight cost) {
+	if(source < 1 || source > getSize() || dest < 1 || dest > getSize() ||
+		source == dest || !Traits::isValid(cost)) {
+		return;
+	}
+
+	vector<Edge> &edges = m_edges[source - 1];
+	for(size_t i = 0; i < edges.size(); i++) {
+		if(edges[i].m_adjVertex == dest - 1) {
+			edges[i].m_weight = cost;
+			return;
+		}
+	}
+	Edge edge = { dest - 1, cost };
+	edges.push_back(edge);
+	m_edgeCount++;
+}
+
+
+// removeEdge
+// removes the edge from source to dest, if there is one
+// preconditions:	none
+// postconditions:	there is no edge source -> dest
+//
+template <typename Weight, typename Payload>
+void BasicGraph<Weight, Payload>::removeEdge(int source, int dest) {
+	if(source < 1 || source > getSize()) {
+		return;
+	}
+
+	vector<Edge> &edges = m_edges[source - 1];
+	for(size_t i = 0; i < edges.size(); i++) {
+		if(edges[i].m_adjVertex == dest - 1) {
+			edges.erase(edges.begin() + i);
+			m_edgeCount--;
+			return;
+		}
+	}
+}
+
+
+// findShortestPath
+// finds the shortest paths from source to every vertex. dist[v - 1] is
+// set to the length of the shortest path to vertex v, or infinity() if
+// there is none, and pred[v - 1] to the vertex before v on it, or 0 if
+// v is source or there is no path.
+// preconditions:	1 <= source <= getSize()
+// postconditions:	dist and pred hold getSize() entries set as above
+//
+template <typename Weight, typename Payload>
+void BasicGraph<Weight, Payload>::findShortestPath(int source,
+	vector<Weight> &dist, vector<int> &pred) const {
+	search(source - 1, -1, dist, pred);
+	for(size_t i = 0; i < pred.size(); i++) {
+		pred[i]++;		// index values to numerical-order values
+	}
+}
+
+
+// query
+// finds the shortest path from source to dest, searching only until dest
+// is reached
+// preconditions:	none
+// postconditions:	returns the shortest path from source to dest, or a
+//					PathResult with m_found = false if there is none
+//
+template <typename Weight, typename Payload>
+typename BasicGraph<Weight, Payload>::PathResult
+	BasicGraph<Weight, Payload>::query(int source, int dest) const {
+	PathResult result;
+	if(source < 1 || source > getSize() || dest < 1 || dest > getSize()) {
+		return(result);
+	}
+
+	vector<Weight> dist;
+	vector<int> pred;
+	search(source - 1, dest - 1, dist, pred);
+	if(dist[dest - 1] == infinity()) {
+		return(result);
+	}
+	result.m_found = true;
+	result.m_dist = dist[dest - 1];
+	for(int vertex = dest - 1; vertex != -1; vertex = pred[vertex]) {
+		result.m_path.push_back(vertex + 1);
+	}
+	reverse(result.m_path.begin(), result.m_path.end());
+	return(result);
+}
+
+
+// search
+// runs Dijkstra's algorithm from the vertex with index value source,
+// stopping once the vertex with index value dest is settled, or at the
+// end if dest is -1
+// preconditions:	source is an index value
+// postconditions:	dist and pred hold getSize() entries, by index
+//					value; every settled vertex has its final distance
+//					and its predecessor's index value, -1 for none
+//
+template <typename Weight, typename Payload>
+void BasicGraph<Weight, Payload>::search(int source, int dest,
+	vector<Weight> &dist, vector<int> &pred) const {
+	dist.assign(getSize(), infinity());
+	pred.assign(getSize(), -1);
+	MinHeap heap;
+	dist[source] = Weight();
+	heap.push(make_pair(Weight(), source));
+
+	while(!heap.empty()) {
+		Weight vertexDist = heap.top().first;
+		int vertex = heap.top().second;
+		heap.pop();
+		if(dist[vertex] < vertexDist) {
+			continue;		// left behind by a later, shorter push
+		}
+		if(vertex == dest) {
+			return;
+		}
+
+		const vector<Edge> &edges = m_edges[vertex];
+		for(size_t i = 0; i < edges.size(); i++) {
+			Weight candidate = Traits::add(vertexDist, edges[i].m_weight);
+			int adj = edges[i].m_adjVertex;
+			if(candidate < dist[adj]) {
+				dist[adj] = candidate;
+				pred[adj] = vertex;
+				heap.push(make_pair(candidate, adj));
+			}
+		}
+	}
+}
+
+#endif
\ No newline at end of file
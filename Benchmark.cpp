@@ -0,0 +1,349 @@
+// Benchmark.cpp		Author: Sam Hoover
+// times the Graph shortest-path engines on generated graphs and prints the
+// results as JSON.
+//
+// Benchmark		Author: Sam Hoover
+//
+// Description:
+// A program, separate from Driver.cpp, that generates a reproducible graph
+// with GraphGenerator and times the main Graph operations on it: building
+// from a file with buildGraph(ifstream&) and buildGraph(GraphLoader&), 
+// building from memory with buildGraph(vector<string>, const EdgeTriple*,
+// int), findShortestPath(), single-pair query(int, int, QueryMode) and 
+// lookup(int, int) calls, queryBatch(...) and copying. The same graph is
+// also built as a BasicGraph<int> and its query(int, int) timed; every
+// answer is checked against Graph's, so a difference between the two stops
+// the program with an error.
+//
+// Functionality:
+// Options are given as --name=value:
+//		--shape=sparse|grid|scalefree|dense		(default sparse)
+//		--vertices=N	--edges=N	--weight=N		(default 2000, 16000, 100)
+//		--engine=BINARY_HEAP|LINEAR_SCAN|FLOYD_WARSHALL|AUTOMATIC|
+//				 DELTA_STEPPING|BUCKET_QUEUE		(default BINARY_HEAP)
+//		--threads=N		(default 0, one per hardware core)
+//		--runs=N		times each whole-graph operation is repeated (default 5)
+//		--queries=N		single-pair queries timed (default 1000)
+//		--seed=N		(default 1)
+//		--file=NAME		where the generated graph is written for the 
+//						file builds (default benchmark_graph.txt)
+// Each operation prints one line holding a JSON object with the settings, 
+// the number of timed calls ("calls"), the total seconds, the throughput 
+// ("perSecond", counting edges for builds and copies, rows for 
+// findShortestPath() and pairs for queries) and the 50th, 90th and 99th 
+// percentile and the maximum latency of one call, in microseconds. Lines 
+// can be collected from several runs and compared to catch regressions or
+// to compare engines.
+//
+// Assumptions:
+// This program assumes the following:
+//		-the table findShortestPath() fills, vertices^2 entries, fits in memory
+//
+#ifndef BENCHMARK_CPP
+#define BENCHMARK_CPP
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BasicGraph.h"
+#include "Graph.h"
+#include "GraphGenerator.h"
+#include "GraphLoader.h"
+using namespace std;
+
+// Options
+// the settings read from the command line
+//
+struct Options {
+	GraphGenerator::Shape m_shape;
+	int m_vertices;
+	int m_edges;
+	int m_weight;
+	Graph::Engine m_engine;
+	int m_threads;
+	int m_runs;
+	int m_queries;
+	unsigned long long m_seed;
+	string m_file;
+};
+
+// engineNames
+// the names --engine accepts, in the order of Graph::Engine
+//
+const char *const engineNames[] = { "LINEAR_SCAN", "BINARY_HEAP", 
+	"FLOYD_WARSHALL", "AUTOMATIC", "DELTA_STEPPING", "BUCKET_QUEUE" };
+const int engineCount = 6;
+
+// readOptions
+// sets options from the command line arguments, starting from the defaults
+// preconditions:	argv holds argc arguments
+// postconditions:	returns true if every argument was understood, else 
+//					prints the one that was not and returns false
+//
+bool readOptions(int argc, char *argv[], Options &options) {
+	options.m_shape = GraphGenerator::RANDOM_SPARSE;
+	options.m_vertices = 2000;
+	options.m_edges = 16000;
+	options.m_weight = 100;
+	options.m_engine = Graph::BINARY_HEAP;
+	options.m_threads = 0;
+	options.m_runs = 5;
+	options.m_queries = 1000;
+	options.m_seed = 1;
+	options.m_file = "benchmark_graph.txt";
+
+	for(int i = 1; i < argc; i++) {
+		string argument = argv[i];
+		size_t equals = argument.find('=');
+		string name = argument.substr(0, equals);
+		string value = (equals == string::npos) ? "" : argument.substr(equals + 1);
+		bool understood = (equals != string::npos);
+		if(name == "--shape") {
+			understood = understood && GraphGenerator::parseShape(value, options.m_shape);
+		} else if(name == "--engine") {
+			int engine = 0;
+			while(engine < engineCount && value != engineNames[engine]) {
+				engine++;
+			}
+			understood = understood && engine < engineCount;
+			options.m_engine = static_cast<Graph::Engine>(engine % engineCount);
+		} else if(name == "--vertices") {
+			options.m_vertices = atoi(value.c_str());
+			understood = understood && options.m_vertices >= 1;
+		} else if(name == "--edges") {
+			options.m_edges = atoi(value.c_str());
+			understood = understood && options.m_edges >= 0;
+		} else if(name == "--weight") {
+			options.m_weight = atoi(value.c_str());
+			understood = understood && options.m_weight >= 1;
+		} else if(name == "--threads") {
+			options.m_threads = atoi(value.c_str());
+		} else if(name == "--runs") {
+			options.m_runs = atoi(value.c_str());
+			understood = understood && options.m_runs >= 1;
+		} else if(name == "--queries") {
+			options.m_queries = atoi(value.c_str());
+			understood = understood && options.m_queries >= 1;
+		} else if(name == "--seed") {
+			options.m_seed = strtoull(value.c_str(), nullptr, 10);
+		} else if(name == "--file") {
+			options.m_file = value;
+		} else {
+			understood = false;
+		}
+
+		if(!understood) {
+			cerr << "Benchmark: cannot use " << argument << endl;
+			return(false);
+		}
+	}
+	return(true);
+}
+
+
+// secondsSince
+// returns the seconds elapsed since start
+// preconditions:	none
+// postconditions:	returns the elapsed time
+//
+double secondsSince(chrono::steady_clock::time_point start) {
+	return(chrono::duration<double>(chrono::steady_clock::now() - start).count());
+}
+
+
+// percentile
+// returns the value below which fraction of the sorted values fall
+// preconditions:	sorted is not empty and in increasing order; 
+//					0 <= fraction <= 1
+// postconditions:	returns the nearest-rank percentile
+//
+double percentile(const vector<double> &sorted, double fraction) {
+	size_t rank = static_cast<size_t>(fraction * sorted.size());
+	return(sorted[min(rank, sorted.size() - 1)]);
+}
+
+
+// report
+// prints one JSON line for operation, whose calls took the given seconds
+// each and handled itemsPerCall items each
+// preconditions:	seconds is not empty
+// postconditions:	the line is sent to the console
+//
+void report(const Options &options, const string &operation, 
+	vector<double> seconds, double itemsPerCall) {
+	sort(seconds.begin(), seconds.end());
+	double total = 0;
+	for(size_t i = 0; i < seconds.size(); i++) {
+		total += seconds[i];
+	}
+	double items = itemsPerCall * seconds.size();
+
+	cout << "{\"operation\":\"" << operation << "\""
+		<< ",\"shape\":\"" << GraphGenerator::shapeName(options.m_shape) << "\""
+		<< ",\"vertices\":" << options.m_vertices
+		<< ",\"edges\":" << options.m_edges
+		<< ",\"engine\":\"" << engineNames[options.m_engine] << "\""
+		<< ",\"threads\":" << options.m_threads
+		<< ",\"seed\":" << options.m_seed
+		<< ",\"calls\":" << seconds.size()
+		<< ",\"seconds\":" << total
+		<< ",\"perSecond\":" << ((total > 0) ? items / total : 0)
+		<< ",\"p50Micros\":" << percentile(seconds, 0.50) * 1e6
+		<< ",\"p90Micros\":" << percentile(seconds, 0.90) * 1e6
+		<< ",\"p99Micros\":" << percentile(seconds, 0.99) * 1e6
+		<< ",\"maxMicros\":" << seconds.back() * 1e6
+		<< "}" << endl;
+}
+
+
+// setUp
+// applies the engine and thread options to graph
+// preconditions:	none
+// postconditions:	graph uses options.m_engine and options.m_threads
+//
+void setUp(Graph &graph, const Options &options) {
+	graph.setEngine(options.m_engine);
+	graph.setThreadCount(options.m_threads);
+}
+
+
+int main(int argc, char *argv[]) {
+	Options options;
+	if(!readOptions(argc, argv, options)) {
+		return(1);
+	}
+
+	GraphGenerator generator(options.m_shape, options.m_vertices, 
+		options.m_edges, options.m_weight, options.m_seed);
+	vector<string> titles;
+	vector<Graph::EdgeTriple> edges;
+	generator.generate(titles, edges);
+	options.m_edges = static_cast<int>(edges.size());
+	if(!GraphGenerator::writeFile(options.m_file, titles, edges)) {
+		cerr << "Benchmark: cannot write " << options.m_file << endl;
+		return(1);
+	}
+	vector<pair<int, int> > pairs = generator.generatePairs(options.m_queries);
+	Graph graph;
+	setUp(graph, options);
+	options.m_threads = graph.getThreadCount();
+	vector<double> seconds;
+
+	// builds
+	seconds.clear();
+	for(int run = 0; run < options.m_runs; run++) {
+		Graph built;
+		setUp(built, options);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		ifstream inFile(options.m_file.c_str());
+		built.buildGraph(inFile);
+		seconds.push_back(secondsSince(start));
+	}
+	report(options, "buildGraph(ifstream)", seconds, options.m_edges);
+
+	seconds.clear();
+	for(int run = 0; run < options.m_runs; run++) {
+		Graph built;
+		setUp(built, options);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		GraphLoader loader(options.m_file);
+		built.buildGraph(loader);
+		seconds.push_back(secondsSince(start));
+	}
+	report(options, "buildGraph(GraphLoader)", seconds, options.m_edges);
+
+	seconds.clear();
+	for(int run = 0; run < options.m_runs; run++) {
+		Graph built;
+		setUp(built, options);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		built.buildGraph(titles, edges.data(), options.m_edges);
+		seconds.push_back(secondsSince(start));
+	}
+	report(options, "buildGraph(EdgeTriple)", seconds, options.m_edges);
+
+	// single-pair queries, before m_table holds any rows
+	graph.buildGraph(titles, edges.data(), options.m_edges);
+	const Graph::QueryMode modes[] = { Graph::DIJKSTRA, Graph::BIDIRECTIONAL };
+	const char *const modeNames[] = { "query(DIJKSTRA)", "query(BIDIRECTIONAL)" };
+	for(int mode = 0; mode < 2; mode++) {
+		graph.query(pairs[0].first, pairs[0].second, modes[mode]);
+		seconds.clear();
+		for(size_t i = 0; i < pairs.size(); i++) {
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			graph.query(pairs[i].first, pairs[i].second, modes[mode]);
+			seconds.push_back(secondsSince(start));
+		}
+		report(options, modeNames[mode], seconds, 1);
+	}
+
+	// the same queries on a BasicGraph, which must give the same lengths
+	seconds.clear();
+	for(int run = 0; run < options.m_runs; run++) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		BasicGraph<int> built(static_cast<int>(titles.size()));
+		for(size_t i = 0; i < edges.size(); i++) {
+			built.insertEdge(edges[i].m_source, edges[i].m_dest, edges[i].m_cost);
+		}
+		seconds.push_back(secondsSince(start));
+	}
+	report(options, "BasicGraph(insertEdge)", seconds, options.m_edges);
+
+	BasicGraph<int> basic(static_cast<int>(titles.size()));
+	for(size_t i = 0; i < edges.size(); i++) {
+		basic.insertEdge(edges[i].m_source, edges[i].m_dest, edges[i].m_cost);
+	}
+	seconds.clear();
+	for(size_t i = 0; i < pairs.size(); i++) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		BasicGraph<int>::PathResult result = basic.query(pairs[i].first, 
+			pairs[i].second);
+		seconds.push_back(secondsSince(start));
+		Graph::PathResult expected = graph.query(pairs[i].first, pairs[i].second);
+		if(result.m_found != expected.m_found || 
+			(result.m_found && result.m_dist != expected.m_dist)) {
+			cerr << "Benchmark: BasicGraph and Graph differ from " 
+				<< pairs[i].first << " to " << pairs[i].second << endl;
+			return(1);
+		}
+	}
+	report(options, "BasicGraph::query", seconds, 1);
+
+	seconds.clear();
+	for(int run = 0; run < options.m_runs; run++) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		graph.queryBatch(pairs);
+		seconds.push_back(secondsSince(start));
+	}
+	report(options, "queryBatch", seconds, options.m_queries);
+
+	// whole table
+	seconds.clear();
+	for(int run = 0; run < options.m_runs; run++) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		graph.findShortestPath();
+		seconds.push_back(secondsSince(start));
+	}
+	report(options, "findShortestPath", seconds, options.m_vertices);
+
+	seconds.clear();
+	for(size_t i = 0; i < pairs.size(); i++) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		graph.lookup(pairs[i].first, pairs[i].second);
+		seconds.push_back(secondsSince(start));
+	}
+	report(options, "lookup", seconds, 1);
+
+	seconds.clear();
+	for(int run = 0; run < options.m_runs; run++) {
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		Graph copy(graph);
+		seconds.push_back(secondsSince(start));
+	}
+	report(options, "copy", seconds, options.m_edges);
+	return(0);
+}
+
+#endif
\ No newline at end of file
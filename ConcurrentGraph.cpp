@@ -0,0 +1,189 @@
+// ConcurrentGraph.cpp	Author: Sam Hoover
+// contains the definitions for the ConcurrentGraph class.
+//
+// ConcurrentGraph		Author: Sam Hoover
+//
+// Description:
+// A Graph shared between many reading threads and the threads that change
+// its edges. The current version of the graph is held in m_current, a
+// reference-counted pointer to a Graph that is never changed once it has
+// been published. Readers take the pointer and search that version; writers
+// copy it, change the copy and publish the copy in its place.
+//
+// Functionality:
+// snapshot() returns the current version. A reader keeps its version alive
+// for as long as it holds the pointer, so a version replaced while it is
+// being searched is only destroyed once its last reader lets go. query(...)
+// and queryBatch(...) search the current version directly. The searches keep
+// their working state per thread, not in the Graph, so any number of
+// threads can search the same version at once.
+//
+// insertEdge(int, int, int), removeEdge(int, int) and insertEdges(...) each
+// copy the current version, make the change on the copy, and publish it.
+// Writers take m_writerMutex, so changes are applied one at a time and none
+// is lost, but readers never take it: m_current is loaded and stored
+// atomically, and a reader sees either the old version or the new one.
+// Each change copies the whole graph, so many edges should be changed with
+// one call to insertEdges(...) rather than one call per edge. Before a
+// version is published it is frozen: its CsrGraph and transpose are built,
+// so no search on it has anything left to build lazily.
+//
+// Assumptions:
+// This class assumes the following:
+//		-readers only call the searches that do not write to m_table on a
+//		 snapshot: query(...), queryBatch(...) and queryAStar(...), along
+//		 with the getters. lookup(...), getPath(...), display(...) and
+//		 findShortestPath() fill m_table and need a Graph of their own.
+//		-the vertices given to the writers are valid, as for Graph
+//
+#ifndef CONCURRENTGRAPH_CPP
+#define CONCURRENTGRAPH_CPP
+#include "ConcurrentGraph.h"
+
+// default constructor
+// creates a ConcurrentGraph whose current version is an empty Graph
+// preconditions:	none
+// postconditions:	m_current points to an empty, frozen Graph
+//
+ConcurrentGraph::ConcurrentGraph() {
+	install(make_shared<Graph>());
+}
+
+
+// constructor(Graph)
+// creates a ConcurrentGraph whose first version is graph. The engine,
+// thread count and other settings of graph are kept by every version.
+// preconditions:	graph is built
+// postconditions:	m_current points to graph, frozen
+//
+ConcurrentGraph::ConcurrentGraph(Graph graph) {
+	install(make_shared<Graph>(move(graph)));
+}
+
+
+// snapshot
+// returns the current version of the graph. The version does not change,
+// and stays alive while the returned pointer is held, even if a writer
+// publishes a new one.
+// preconditions:	none
+// postconditions:	returns m_current
+//
+shared_ptr<const Graph> ConcurrentGraph::snapshot() const {
+	return(atomic_load(&m_current));
+}
+
+
+// query
+// finds the shortest path from source to dest in the current version, as
+// Graph::query(int, int, QueryMode) does
+// preconditions:	source and dest must be the numerical-order value of the
+//					vertices they represent (not the index value)
+// postconditions:	returns the shortest path from source to dest, or a
+//					PathResult with m_found = false if there is none
+//
+Graph::PathResult ConcurrentGraph::query(int source, int dest,
+	Graph::QueryMode mode) const {
+	return(snapshot()->query(source, dest, mode));
+}
+
+
+// queryBatch
+// finds the shortest path for every (source, dest) pair in pairs in the
+// current version, as Graph::queryBatch(...) does. Every pair is answered
+// from the same version.
+// preconditions:	the pairs hold numerical-order values (not index values)
+// postconditions:	returns the answers in pairs' order; a pair with an
+//					invalid vertex has no path
+//
+Graph::BatchResult ConcurrentGraph::queryBatch(
+	const vector<pair<int, int> > &pairs) const {
+	return(snapshot()->queryBatch(pairs));
+}
+
+
+// insertEdge
+// publishes a new version with an edge from source to dest of weight cost,
+// replacing the weight of the edge if there is one already
+// preconditions:	source and dest must be the numerical-order value of the
+//					vertices they represent (not the index value)
+// postconditions:	m_current points to a new, frozen version holding the
+//					edge
+//
+void ConcurrentGraph::insertEdge(int source, int dest, int cost) {
+	lock_guard<mutex> lock(m_writerMutex);
+	shared_ptr<Graph> next = copyCurrent();
+	next->insertEdge(source, dest, cost);
+	install(next);
+}
+
+
+// removeEdge
+// publishes a new version without the edge from source to dest
+// preconditions:	source and dest must be the numerical-order value of the
+//					vertices they represent (not the index value)
+// postconditions:	m_current points to a new, frozen version without the
+//					edge
+//
+void ConcurrentGraph::removeEdge(int source, int dest) {
+	lock_guard<mutex> lock(m_writerMutex);
+	shared_ptr<Graph> next = copyCurrent();
+	next->removeEdge(source, dest);
+	install(next);
+}
+
+
+// insertEdges
+// publishes a new version with every edge in edges inserted, as
+// Graph::insertEdges(const EdgeTriple*, int) does, copying the graph once
+// for all of them
+// preconditions:	edges holds count entries with numerical-order values
+// postconditions:	m_current points to a new, frozen version holding the
+//					edges
+//
+void ConcurrentGraph::insertEdges(const Graph::EdgeTriple *edges, 
+	int count) {
+	lock_guard<mutex> lock(m_writerMutex);
+	shared_ptr<Graph> next = copyCurrent();
+	next->insertEdges(edges, count);
+	install(next);
+}
+
+
+// publish
+// replaces the current version with graph, such as a Graph built again
+// from a new file
+// preconditions:	graph is built
+// postconditions:	m_current points to graph, frozen
+//
+void ConcurrentGraph::publish(Graph graph) {
+	lock_guard<mutex> lock(m_writerMutex);
+	install(make_shared<Graph>(move(graph)));
+}
+
+
+// copyCurrent
+// returns a copy of the current version for a writer to change
+// preconditions:	m_writerMutex is held
+// postconditions:	returns a Graph equal to *m_current
+//
+shared_ptr<Graph> ConcurrentGraph::copyCurrent() const {
+	return(make_shared<Graph>(*snapshot()));
+}
+
+
+// install
+// freezes next and makes it the current version
+// preconditions:	m_writerMutex is held, or the ConcurrentGraph is being
+//					constructed
+// postconditions:	next's CsrGraph and transpose are built; m_current
+//					points to next
+//
+void ConcurrentGraph::install(shared_ptr<Graph> next) {
+	// build everything the searches would otherwise build on first use, 
+	// since once next is published no thread may change it
+	next->getCsr();
+	next->getReverseCsr();
+	atomic_store(&m_current, shared_ptr<const Graph>(move(next)));
+}
+
+#endif
\ No newline at end of file
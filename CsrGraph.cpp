@@ -0,0 +1,200 @@
+// CsrGraph.cpp		Author: Sam Hoover
+// contains the definitions for the CsrGraph class.
+//
+// CsrGraph		Author: Sam Hoover
+//
+// Description:
+// A frozen, read-only view of a weighted graph's edges in compressed sparse 
+// row (CSR) layout. The outgoing edges of vertex v are stored contiguously at
+// positions m_offsets[v] through m_offsets[v + 1] - 1 of the packed 
+// m_adjVertices and m_weights arrays, in the same order as the Graph edge 
+// linked list they were built from. All vertex values are index values (not
+// the numerical-order values used by Graph's public methods).
+//
+// Functionality:
+// A CsrGraph is built once, usually by Graph, and never modified afterwards.
+// Because it is immutable it can be copied or shared between threads freely.
+// The shortest-path engines read the raw arrays returned by getOffsets(),
+// getAdjVertices() and getWeights() so the relaxation loop walks memory 
+// sequentially instead of chasing Edge pointers. reversed() builds the 
+// transpose, whose lists hold each vertex's incoming edges, for searches that
+// walk the graph backward from a destination.
+//
+// The arrays are either owned by the CsrGraph or borrowed from memory owned 
+// by something else, such as a memory-mapped GraphFile; m_storage keeps 
+// that owner alive for as long as any copy of the CsrGraph exists, so 
+// copies are cheap and never copy the arrays.
+//
+// Assumptions:
+// This class assumes the following:
+//		-offsets holds size + 1 non-decreasing values starting at 0 and ending
+//		 at adjVertices.size()
+//		-adjVertices and weights are the same length
+//
+#ifndef CSRGRAPH_CPP
+#define CSRGRAPH_CPP
+#include <utility>
+#include "CsrGraph.h"
+
+// default constructor
+// creates an empty CsrGraph with no vertices or edges
+// preconditions:	none
+// postconditions:	m_size = 0; m_maxWeight = 0; m_offsets = { 0 }
+//
+CsrGraph::CsrGraph() : m_size(0), m_edgeCount(0), m_maxWeight(0) {
+	static const int emptyOffsets[1] = { 0 };
+	m_offsets = emptyOffsets;
+	m_adjVertices = nullptr;
+	m_weights = nullptr;
+}
+
+
+// constructor(int, vector<int>, vector<int>, vector<int>)
+// creates a CsrGraph with m_size vertices that takes ownership of the given
+// offset, adjacent vertex and weight arrays
+// preconditions:	offsets, adjVertices and weights satisfy the class 
+//					assumptions
+// postconditions:	m_size = size; m_offsets = offsets; 
+//					m_adjVertices = adjVertices; m_weights = weights
+//
+CsrGraph::CsrGraph(int size, vector<int> offsets, vector<int> adjVertices,
+	vector<int> weights) : m_size(size), 
+	m_edgeCount(static_cast<int>(adjVertices.size())) {
+	shared_ptr<Arrays> arrays = make_shared<Arrays>();
+	arrays->m_offsets = std::move(offsets);
+	arrays->m_adjVertices = std::move(adjVertices);
+	arrays->m_weights = std::move(weights);
+	m_offsets = arrays->m_offsets.data();
+	m_adjVertices = arrays->m_adjVertices.data();
+	m_weights = arrays->m_weights.data();
+	m_storage = arrays;
+	m_maxWeight = findMaxWeight(m_weights, m_edgeCount);
+}
+
+
+// constructor(int, int, const int*, const int*, const int*, 
+//				shared_ptr<const void>)
+// creates a CsrGraph with m_size vertices and edgeCount edges that reads
+// the given arrays in place, without copying them
+// preconditions:	the arrays satisfy the class assumptions and stay valid
+//					and unchanged for as long as storage is alive
+// postconditions:	m_size = size; the arrays are borrowed and m_storage
+//					= storage
+//
+CsrGraph::CsrGraph(int size, int edgeCount, const int *offsets, 
+	const int *adjVertices, const int *weights, 
+	shared_ptr<const void> storage) : m_size(size), m_edgeCount(edgeCount),
+	m_maxWeight(findMaxWeight(weights, edgeCount)), m_offsets(offsets), 
+	m_adjVertices(adjVertices), m_weights(weights), 
+	m_storage(std::move(storage)) {}
+
+
+// getSize
+// returns the number of vertices
+// preconditions:	none
+// postconditions:	returns m_size
+//
+int CsrGraph::getSize() const {
+	return(m_size);
+}
+
+
+// getEdgeCount
+// returns the number of edges
+// preconditions:	none
+// postconditions:	returns m_edgeCount
+//
+int CsrGraph::getEdgeCount() const {
+	return(m_edgeCount);
+}
+
+
+// getMaxWeight
+// returns the largest edge weight, or 0 if there are no edges
+// preconditions:	none
+// postconditions:	returns m_maxWeight
+//
+int CsrGraph::getMaxWeight() const {
+	return(m_maxWeight);
+}
+
+
+// getOffsets
+// returns the offset array, holding getSize() + 1 entries
+// preconditions:	none
+// postconditions:	returns a pointer to the first entry of m_offsets
+//
+const int *CsrGraph::getOffsets() const {
+	return(m_offsets);
+}
+
+
+// getAdjVertices
+// returns the packed adjacent vertex array, holding getEdgeCount() entries
+// preconditions:	none
+// postconditions:	returns a pointer to the first entry of m_adjVertices
+//
+const int *CsrGraph::getAdjVertices() const {
+	return(m_adjVertices);
+}
+
+
+// getWeights
+// returns the packed weight array, holding getEdgeCount() entries
+// preconditions:	none
+// postconditions:	returns a pointer to the first entry of m_weights
+//
+const int *CsrGraph::getWeights() const {
+	return(m_weights);
+}
+
+
+// reversed
+// returns the transpose of this graph. Vertex v's list in the transpose
+// holds an edge to u with weight w for every edge u -> v of weight w here,
+// ordered by u.
+// preconditions:	none
+// postconditions:	returns a CsrGraph with every edge reversed
+//
+CsrGraph CsrGraph::reversed() const {
+	// count incoming edges, then turn the counts into offsets
+	vector<int> offsets(m_size + 1, 0);
+	for(int i = 0; i < m_edgeCount; i++) {
+		offsets[m_adjVertices[i] + 1]++;
+	}
+	for(int i = 0; i < m_size; i++) {
+		offsets[i + 1] += offsets[i];
+	}
+
+	vector<int> next(offsets.begin(), offsets.end() - 1);
+	vector<int> adjVertices(m_edgeCount);
+	vector<int> weights(m_edgeCount);
+	for(int u = 0; u < m_size; u++) {
+		for(int i = m_offsets[u]; i < m_offsets[u + 1]; i++) {
+			int pos = next[m_adjVertices[i]]++;
+			adjVertices[pos] = u;
+			weights[pos] = m_weights[i];
+		}
+	}
+	return(CsrGraph(m_size, std::move(offsets), std::move(adjVertices),
+		std::move(weights)));
+}
+
+
+// findMaxWeight
+// returns the largest of the first edgeCount weights, or 0 if there are
+// none
+// preconditions:	weights holds at least edgeCount entries
+// postconditions:	returns the largest weight
+//
+int CsrGraph::findMaxWeight(const int *weights, int edgeCount) {
+	int maxWeight = 0;
+	for(int i = 0; i < edgeCount; i++) {
+		if(weights[i] > maxWeight) {
+			maxWeight = weights[i];
+		}
+	}
+	return(maxWeight);
+}
+
+#endif
\ No newline at end of file
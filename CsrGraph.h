@@ -0,0 +1,151 @@
+// CsrGraph.h		Author: Sam Hoover
+// contains the declarations for the CsrGraph class.
+//
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+#include <vector>
+#include <memory>
+using namespace std;
+
+// CsrGraph		Author: Sam Hoover
+//
+// Description:
+// A frozen, read-only view of a weighted graph's edges in compressed sparse 
+// row (CSR) layout. The outgoing edges of vertex v are stored contiguously at
+// positions m_offsets[v] through m_offsets[v + 1] - 1 of the packed 
+// m_adjVertices and m_weights arrays, in the same order as the Graph edge 
+// linked list they were built from. All vertex values are index values (not
+// the numerical-order values used by Graph's public methods).
+//
+// Functionality:
+// A CsrGraph is built once, usually by Graph, and never modified afterwards.
+// Because it is immutable it can be copied or shared between threads freely.
+// The shortest-path engines read the raw arrays returned by getOffsets(),
+// getAdjVertices() and getWeights() so the relaxation loop walks memory 
+// sequentially instead of chasing Edge pointers. reversed() builds the 
+// transpose, whose lists hold each vertex's incoming edges, for searches that
+// walk the graph backward from a destination.
+//
+// The arrays are either owned by the CsrGraph or borrowed from memory owned 
+// by something else, such as a memory-mapped GraphFile; m_storage keeps 
+// that owner alive for as long as any copy of the CsrGraph exists, so 
+// copies are cheap and never copy the arrays.
+//
+// Assumptions:
+// This class assumes the following:
+//		-offsets holds size + 1 non-decreasing values starting at 0 and ending
+//		 at adjVertices.size()
+//		-adjVertices and weights are the same length
+//
+class CsrGraph {
+public:
+	// default constructor
+	// creates an empty CsrGraph with no vertices or edges
+	// preconditions:	none
+	// postconditions:	m_size = 0; m_maxWeight = 0; m_offsets = { 0 }
+	//
+	CsrGraph();
+
+	// constructor(int, vector<int>, vector<int>, vector<int>)
+	// creates a CsrGraph with m_size vertices that takes ownership of the given
+	// offset, adjacent vertex and weight arrays
+	// preconditions:	offsets, adjVertices and weights satisfy the class 
+	//					assumptions
+	// postconditions:	m_size = size; m_offsets = offsets; 
+	//					m_adjVertices = adjVertices; m_weights = weights
+	//
+	CsrGraph(int size, vector<int> offsets, vector<int> adjVertices,
+		vector<int> weights);
+
+	// constructor(int, int, const int*, const int*, const int*, 
+	//				shared_ptr<const void>)
+	// creates a CsrGraph with m_size vertices and edgeCount edges that reads
+	// the given arrays in place, without copying them
+	// preconditions:	the arrays satisfy the class assumptions and stay valid
+	//					and unchanged for as long as storage is alive
+	// postconditions:	m_size = size; the arrays are borrowed and m_storage
+	//					= storage
+	//
+	CsrGraph(int size, int edgeCount, const int *offsets, 
+		const int *adjVertices, const int *weights, 
+		shared_ptr<const void> storage);
+
+	// getSize
+	// returns the number of vertices
+	// preconditions:	none
+	// postconditions:	returns m_size
+	//
+	int getSize() const;
+
+	// getEdgeCount
+	// returns the number of edges
+	// preconditions:	none
+	// postconditions:	returns m_edgeCount
+	//
+	int getEdgeCount() const;
+
+	// getMaxWeight
+	// returns the largest edge weight, or 0 if there are no edges
+	// preconditions:	none
+	// postconditions:	returns m_maxWeight
+	//
+	int getMaxWeight() const;
+
+	// getOffsets
+	// returns the offset array, holding getSize() + 1 entries
+	// preconditions:	none
+	// postconditions:	returns a pointer to the first entry of m_offsets
+	//
+	const int *getOffsets() const;
+
+	// getAdjVertices
+	// returns the packed adjacent vertex array, holding getEdgeCount() entries
+	// preconditions:	none
+	// postconditions:	returns a pointer to the first entry of m_adjVertices
+	//
+	const int *getAdjVertices() const;
+
+	// getWeights
+	// returns the packed weight array, holding getEdgeCount() entries
+	// preconditions:	none
+	// postconditions:	returns a pointer to the first entry of m_weights
+	//
+	const int *getWeights() const;
+
+	// reversed
+	// returns the transpose of this graph. Vertex v's list in the transpose
+	// holds an edge to u with weight w for every edge u -> v of weight w here,
+	// ordered by u.
+	// preconditions:	none
+	// postconditions:	returns a CsrGraph with every edge reversed
+	//
+	CsrGraph reversed() const;
+
+private:
+	// Arrays
+	// the storage of a CsrGraph that owns its arrays
+	//
+	struct Arrays {
+		vector<int> m_offsets;
+		vector<int> m_adjVertices;
+		vector<int> m_weights;
+	};
+
+	int m_size;
+	int m_edgeCount;
+	int m_maxWeight;
+	const int *m_offsets;
+	const int *m_adjVertices;
+	const int *m_weights;
+	shared_ptr<const void> m_storage;	// keeps the arrays alive
+
+	// findMaxWeight
+	// returns the largest of the first edgeCount weights, or 0 if there are
+	// none
+	// preconditions:	weights holds at least edgeCount entries
+	// postconditions:	returns the largest weight
+	//
+	static int findMaxWeight(const int *weights, int edgeCount);
+};
+
+#endif
\ No newline at end of file
@@ -5,38 +5,133 @@
 //
 // Description:
 // A class representing a number, n, of single-source, weighted graphs, 
-// where 0 < n < 100. The graph's vertices and edges are stored in an adjacency
-// list, m_vertices. All shortest paths are stored in a matrix of size 100x100,
-// m_table, where each row corresponds to one set of shortest paths, and each 
-// column corresponds to a vertex in the graph. 
+// where n > 0. The primary purpose of this class is to build a graph and
+// then perform Dijkstra's Algorithm on it to determine the shortest paths. The
+// graph's vertices and edges are stored in an adjacency list, m_vertices, sized
+// from the input. Shortest paths are stored in m_table, a cache of rows where
+// each row corresponds to one set of shortest paths from a single source, and
+// each column corresponds to a vertex in the graph. A row is computed the 
+// first time it is needed and kept until an edge change affects it or it is
+// evicted to stay within the row limit.
 //
 // Functionality:
 // A Graph object must be built from a properly formated file using the class's
-// buildGraph(ifsteam&) method. Once a Graph object is built, Edges can be 
-// inserted or removed, if they exist, using the insertEdge(int, int, int) and 
-// removeEdge(int, int) methods, respectively. Inserting an edge between two 
+// buildGraph(ifsteam&) method, or buildGraph(GraphLoader&) for large files. 
+// Once a Graph object is built, Edges can be inserted or removed, if they 
+// exist, using the insertEdge(int, int, int) and removeEdge(int, int) 
+// methods, respectively. Inserting an edge between two 
 // vertices where an edge already exists replaces the existing edge's weight
-// with the new edge's weight. Once a graph is built as desired, the
-// findShortestPath() method can be called to instantiate and fill the m_table
-// matrix. After findShortestPath() has been called, any changes to m_vertices 
-// will not be recorded in m_table until findShortestPath() is called again. When 
-// findShortestPath() has been called at least once, the shortest paths can be
-// displayed using the displayAll() and display(int, int) methods. The displayAll()
-// method displays all shortest paths, with each vertex as the source. The
-// display(int source, int dest) method displays a single shortest path from
-// source to dest, along with data stored at those locations. For display to 
-// show the most current shortest paths, findShortestPath() must be called
-// after any changes have been made to the graph.
+// with the new edge's weight. Edges already held in memory can be loaded 
+// in one pass, with the same rules, by insertEdges(const EdgeTriple*, int),
+// or used to build a whole graph by buildGraph(vector<string>, 
+// const EdgeTriple*, int).
+//
+// The shortest paths can be displayed using the displayAll() and 
+// display(int, int) methods, or returned as a PathResult by lookup(int, int).
+// getPath(int, int, int*, int) and getPathLocations(...) write a single 
+// shortest path into a buffer supplied by the caller instead, without
+// allocating; both display methods format the paths they return.
+// The displayAll() method displays all shortest paths, with each vertex as the
+// source. The display(int source, int dest) method displays a single shortest
+// path from source to dest, along with data stored at those locations. These
+// methods compute any row of m_table they need that is missing or out of 
+// date; findShortestPath() computes every row at once instead. Each row is 
+// stamped with the graph version, m_version, it is current for. m_version 
+// changes whenever the edges change, and insertEdge(int, int, int) and 
+// removeEdge(int, int) restamp every row the change cannot affect, so only
+// the affected rows are computed again. If setIncrementalRepair(true) has been
+// called, the affected rows are repaired in place instead: only the entries
+// whose shortest path uses the changed edge, or can now be shortened by it, 
+// are recomputed. setRowLimit(int) bounds the number of rows kept, evicting 
+// the least recently used row when a new one is needed.
+//
+// Edges and GraphData objects are not allocated one at a time; they are 
+// carved out of two NodePools owned by the Graph, m_edgePool and m_dataPool,
+// so that building a graph takes a few large allocations and emptying it 
+// returns every Edge at once instead of walking the linked lists. Once a
+// vertex has EDGE_INDEX_MIN edges, its linked list is indexed by an 
+// EdgeIndex hash table, so inserting, replacing or removing one of its 
+// edges no longer walks the list and building a high-degree vertex is not
+// quadratic in its degree.
+//
+// writeFile(string, bool) saves the graph, and optionally the current rows of
+// m_table, as a binary GraphFile; openFile(string) opens one again. Opening
+// a file maps it into memory and uses its edges in place as m_csr, so the 
+// Edge linked lists are only built if an edge is later inserted or removed.
+//
+// The algorithm used to pick the next vertex to visit can be selected at
+// runtime with setEngine(Engine), so that different engines can be compared on
+// the same graph. The engines do not walk the Edge linked lists directly; they
+// read a frozen CsrGraph copy of the edges, m_csr, which is rebuilt on demand
+// after the edges change and can be shared with other threads or Graph copies
+// through getCsr(). Because each row of m_table only depends on its own 
+// source, findShortestPath() can fill the rows on several threads at once; 
+// setThreadCount(int) selects how many. The threads live in a ThreadPool,
+// m_pool, that is started when first needed and reused by later searches
+// and edge changes, so they are not started again for every row. For graphs too large to search 
+// from many sources at once, the DELTA_STEPPING engine instead splits each
+// single-source search between the threads. When Graph is compiled with 
+// GRAPH_STATS defined, the engines count their work and time their phases
+// in a SearchStats, read with getSearchStats(); otherwise the counting code
+// is not compiled at all.
+//
+// A single shortest path can also be found without m_table by calling
+// query(int, int), which searches from source only until dest is reached.
+// query(int, int, QueryMode) can instead search from both ends at once, 
+// walking backward from dest over the transpose of m_csr, m_reverseCsr.
+// When the vertices carry coordinates, queryAStar(int, int, Heuristic) guides
+// the search toward dest with a distance estimate such as EuclideanHeuristic.
+// To serve these queries from many threads while the edges change, a
+// ConcurrentGraph publishes each change as a new, frozen copy of the Graph.
 //
 // Assumptions:	
 // This class assumes the following:
 //		-file input is entered in the proper format, as outlined in the HW3
-//		 assignment specification.
-//		-buildGraph(ifstream&) is called to properly build a Graph object
+//		 assignment specification. A vertex description may end with 
+//		 "@ x y" to give the vertex coordinates, e.g. "Zoo @ 47.66 -122.35".
+//		-buildGraph(ifstream&) or buildGraph(GraphLoader&) is called to 
+//		 properly build a Graph object
+//		-every shortest path is shorter than INFINITY; a path whose length
+//		 would reach INFINITY is treated as no path, and BasicGraph<int64_t>
+//		 holds the lengths of graphs whose paths are longer
 //
 #ifndef GRAPH_CPP
 #define GRAPH_CPP
 #include "Graph.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <sstream>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// GRAPH_STATS_COUNT, GRAPH_STATS_START, GRAPH_STATS_LAP and 
+// GRAPH_STATS_RECORD gather a SearchStats while rows of m_table are 
+// computed. Unless GRAPH_STATS is defined they compile to nothing, so the
+// search loops carry no counting code.
+#ifdef GRAPH_STATS
+#define GRAPH_STATS_COUNT(field, amount) (threadStats().field += (amount))
+#define GRAPH_STATS_START() lapStats(nullptr)
+#define GRAPH_STATS_LAP(field) lapStats(&threadStats().field)
+#define GRAPH_STATS_RECORD() recordStats()
+#else
+#define GRAPH_STATS_COUNT(field, amount) ((void)0)
+#define GRAPH_STATS_START() ((void)0)
+#define GRAPH_STATS_LAP(field) ((void)0)
+#define GRAPH_STATS_RECORD() ((void)0)
+#endif
+
+const int Graph::INFINITY;
+const int Graph::SMALL_PRED_LIMIT;
+const int Graph::AUTOMATIC_DENSITY;
+const int Graph::FLOYD_INFINITY;
+const int Graph::FLOYD_BLOCK;
+const int Graph::DELTA_CHUNK;
+const int Graph::REPAIR_PARALLEL_MIN;
+const int Graph::BUCKET_LIMIT;
+const int Graph::EDGE_INDEX_MIN;
 
 // Vertex default constructor
 // creates a Vertex with m_data and m_edgeHead equal to nullptr
@@ -80,12 +175,243 @@ Graph::Edge::Edge(int weight, int adj) : m_nextEdge(nullptr) {
 }
 
 
+// EdgeIndex default constructor
+// creates an EdgeIndex that has not been built
+// preconditions:	none
+// postconditions:	m_adjVertices and m_prevEdges are empty; m_count = 0; 
+//					m_lastEdge = nullptr
+//
+Graph::EdgeIndex::EdgeIndex() : m_count(0), m_lastEdge(nullptr) {}
+
+
+// EdgeIndex isBuilt
+// returns true if the index has been built, else false
+// preconditions:	none
+// postconditions:	returns true if m_adjVertices is not empty
+//
+bool Graph::EdgeIndex::isBuilt() const {
+	return(!m_adjVertices.empty());
+}
+
+
+// EdgeIndex build
+// indexes every Edge in the linked list starting at head
+// preconditions:	no two Edges in the list have the same m_adjVertex
+// postconditions:	the index is built and holds every Edge in the list; 
+//					m_lastEdge is the last of them
+//
+void Graph::EdgeIndex::build(Edge *head) {
+	int count = 0;
+	for(Edge *edge = head; edge != nullptr; edge = edge->m_nextEdge) {
+		count++;
+	}
+	int capacity = 4;
+	while(capacity <= 2 * count) {
+		capacity *= 2;
+	}
+	m_adjVertices.assign(capacity, -1);
+	m_prevEdges.assign(capacity, nullptr);
+	m_count = 0;
+	m_lastEdge = nullptr;
+	for(Edge *edge = head; edge != nullptr; edge = edge->m_nextEdge) {
+		insert(edge->m_adjVertex, m_lastEdge);
+		m_lastEdge = edge;
+	}
+}
+
+
+// EdgeIndex find
+// returns the slot holding the Edge to adj, or -1 if there is none
+// preconditions:	the index is built
+// postconditions:	returns the slot, or -1
+//
+int Graph::EdgeIndex::find(int adj) const {
+	int mask = static_cast<int>(m_adjVertices.size()) - 1;
+	for(int slot = slotOf(adj); m_adjVertices[slot] != -1; slot = (slot + 1) & mask) {
+		if(m_adjVertices[slot] == adj) {
+			return(slot);
+		}
+	}
+	return(-1);
+}
+
+
+// EdgeIndex insert
+// adds the Edge to adj, whose previous Edge in the list is prevEdge, 
+// growing the table if it would become more than half full
+// preconditions:	the index is built and holds no Edge to adj
+// postconditions:	find(adj) returns a slot whose m_prevEdges entry is
+//					prevEdge
+//
+void Graph::EdgeIndex::insert(int adj, Edge *prevEdge) {
+	if(2 * (m_count + 1) > static_cast<int>(m_adjVertices.size())) {
+		resize(2 * static_cast<int>(m_adjVertices.size()));
+	}
+	int mask = static_cast<int>(m_adjVertices.size()) - 1;
+	int slot = slotOf(adj);
+	while(m_adjVertices[slot] != -1) {
+		slot = (slot + 1) & mask;
+	}
+	m_adjVertices[slot] = adj;
+	m_prevEdges[slot] = prevEdge;
+	m_count++;
+}
+
+
+// EdgeIndex erase
+// removes the Edge in slot, moving later entries of its probe run back so
+// that no slot is left marked as deleted
+// preconditions:	slot was returned by find(...)
+// postconditions:	the Edge is no longer indexed
+//
+void Graph::EdgeIndex::erase(int slot) {
+	int mask = static_cast<int>(m_adjVertices.size()) - 1;
+	int hole = slot;
+	for(int next = (hole + 1) & mask; m_adjVertices[next] != -1; next = (next + 1) & mask) {
+		// an entry may fill the hole if the hole is on its probe path
+		int home = slotOf(m_adjVertices[next]);
+		if(((next - home) & mask) >= ((next - hole) & mask)) {
+			m_adjVertices[hole] = m_adjVertices[next];
+			m_prevEdges[hole] = m_prevEdges[next];
+			hole = next;
+		}
+	}
+	m_adjVertices[hole] = -1;
+	m_prevEdges[hole] = nullptr;
+	m_count--;
+}
+
+
+// EdgeIndex slotOf
+// returns the slot where the search for adj begins
+// preconditions:	the table is not empty
+// postconditions:	returns a slot of the table
+//
+int Graph::EdgeIndex::slotOf(int adj) const {
+	unsigned int hash = static_cast<unsigned int>(adj) * 2654435769u;
+	hash ^= hash >> 16;
+	return(static_cast<int>(hash & (m_adjVertices.size() - 1)));
+}
+
+
+// EdgeIndex resize
+// moves every entry into a new, empty table of capacity slots
+// preconditions:	capacity is a power of 2 greater than 2 * m_count
+// postconditions:	the table holds capacity slots and the same entries
+//
+void Graph::EdgeIndex::resize(int capacity) {
+	vector<int> adjVertices(capacity, -1);
+	vector<Edge *> prevEdges(capacity, nullptr);
+	adjVertices.swap(m_adjVertices);
+	prevEdges.swap(m_prevEdges);
+	m_count = 0;
+	for(size_t i = 0; i < adjVertices.size(); i++) {
+		if(adjVertices[i] != -1) {
+			insert(adjVertices[i], prevEdges[i]);
+		}
+	}
+}
+
+
+// PathResult default constructor
+// creates a PathResult representing no path
+// preconditions:	none
+// postconditions:	m_found = false; m_dist = INFINITY; m_path is empty;
+//					m_settled = 0
+//
+Graph::PathResult::PathResult() : m_found(false), m_dist(INFINITY), 
+	m_settled(0) {}
+
+
+// BatchResult default constructor
+// creates a BatchResult holding no answers
+// preconditions:	none
+// postconditions:	m_pathStart = { 0 }; m_searches = 0; the other
+//					arrays are empty
+//
+Graph::BatchResult::BatchResult() : m_pathStart(1, 0), m_searches(0) {}
+
+
+// SearchStats default constructor
+// creates a SearchStats representing no work
+// preconditions:	none
+// postconditions:	every field is 0
+//
+Graph::SearchStats::SearchStats() : m_rows(0), m_settled(0), 
+	m_edgesScanned(0), m_relaxations(0), m_pushes(0), m_pops(0), 
+	m_resetSeconds(0), m_searchSeconds(0), m_pathSeconds(0) {}
+
+
+// SearchStats add
+// adds every field of stats to this
+// preconditions:	none
+// postconditions:	each field is the sum of its old value and stats'
+//
+void Graph::SearchStats::add(const SearchStats &stats) {
+	m_rows += stats.m_rows;
+	m_settled += stats.m_settled;
+	m_edgesScanned += stats.m_edgesScanned;
+	m_relaxations += stats.m_relaxations;
+	m_pushes += stats.m_pushes;
+	m_pops += stats.m_pops;
+	m_resetSeconds += stats.m_resetSeconds;
+	m_searchSeconds += stats.m_searchSeconds;
+	m_pathSeconds += stats.m_pathSeconds;
+}
+
+
+// Scratch prepare
+// grows the arrays to hold at least size vertices
+// preconditions:	all entries are clean
+// postconditions:	m_dist, m_path and m_visited hold at least size clean
+//					entries
+//
+void Graph::Scratch::prepare(int size) {
+	if(static_cast<int>(m_dist.size()) < size) {
+		m_dist.resize(size, INFINITY);
+		m_path.resize(size, -1);
+		m_visited.resize(size, false);
+	}
+}
+
+
+// Scratch reach
+// records a new tentative distance and predecessor for vertex
+// preconditions:	vertex is less than the prepared size
+// postconditions:	m_dist[vertex] = dist; m_path[vertex] = path
+//
+void Graph::Scratch::reach(int vertex, int dist, int path) {
+	if(m_dist[vertex] == INFINITY) {
+		m_touched.push_back(vertex);
+	}
+	m_dist[vertex] = dist;
+	m_path[vertex] = path;
+}
+
+
+// Scratch clear
+// resets every entry changed since the last clear()
+// preconditions:	none
+// postconditions:	all entries are clean and m_touched is empty
+//
+void Graph::Scratch::clear() {
+	for(size_t i = 0; i < m_touched.size(); i++) {
+		m_dist[m_touched[i]] = INFINITY;
+		m_path[m_touched[i]] = -1;
+		m_visited[m_touched[i]] = false;
+	}
+	m_touched.clear();
+}
+
+
 // Graph default constructor
 // create a Graph object with m_size equal to 0
 // preconditions:	none
 // postconditions:	m_size = 0
 //
-Graph::Graph() : m_size(0) {}
+Graph::Graph() : m_size(0), m_engine(BINARY_HEAP), m_threadCount(1),
+	m_deltaWidth(0), m_incrementalRepair(false), m_rowLimit(0), m_version(1), 
+	m_edgesInCsr(false), m_incomingVersion(0) {}
 
 
 // copy constructor (deep copy)
@@ -96,17 +422,81 @@ Graph::Graph() : m_size(0) {}
 // postconditions:	m_size = graph.m_size; m_vertices = graph.m_vertices;
 //					m_table = graph.m_table.
 //
-Graph::Graph(const Graph &graph) {
-	empty();
-	resetTable();
+Graph::Graph(const Graph &graph) : m_size(0), m_engine(graph.m_engine),
+	m_threadCount(graph.m_threadCount), m_deltaWidth(graph.m_deltaWidth),
+	m_incrementalRepair(graph.m_incrementalRepair), 
+	m_rowLimit(graph.m_rowLimit), m_version(graph.m_version), 
+	m_edgesInCsr(graph.m_edgesInCsr), m_csr(graph.m_csr), 
+	m_reverseCsr(graph.m_reverseCsr), m_incoming(graph.m_incoming), 
+	m_incomingVersion(graph.m_incomingVersion) {
 	if(graph.m_size > 0) {
 		m_size = graph.m_size;
+		m_vertices.resize(m_size);
 		copyVertices(graph);
 		copyTable(graph);
 	}
 }
 
 
+// move constructor
+// creates a Graph object that takes over the vertices, edges, m_table and
+// settings of graph without copying them. It cannot throw, so containers
+// of Graphs move their Graphs when they grow instead of copying them.
+// preconditions:	none
+// postconditions:	this holds graph's former contents; graph is empty
+//
+Graph::Graph(Graph &&graph) noexcept : Graph() {
+	swap(graph);
+}
+
+
+// assignment operator
+// replaces the contents of this with those of graph. graph is a copy of
+// the argument, or the argument itself moved in, so copy assignment makes
+// a deep copy and move assignment copies nothing.
+// preconditions:	none
+// postconditions:	this holds what the argument held
+//
+Graph &Graph::operator=(Graph graph) noexcept {
+	swap(graph);
+	return(*this);
+}
+
+
+// swap
+// exchanges the vertices, edges, m_table and settings of this and graph
+// in constant time
+// preconditions:	none
+// postconditions:	this holds graph's former contents and graph holds 
+//					this's
+//
+void Graph::swap(Graph &graph) noexcept {
+	std::swap(m_size, graph.m_size);
+	std::swap(m_engine, graph.m_engine);
+	std::swap(m_threadCount, graph.m_threadCount);
+	std::swap(m_deltaWidth, graph.m_deltaWidth);
+	std::swap(m_incrementalRepair, graph.m_incrementalRepair);
+	std::swap(m_rowLimit, graph.m_rowLimit);
+	std::swap(m_version, graph.m_version);
+	m_vertices.swap(graph.m_vertices);
+	std::swap(m_edgesInCsr, graph.m_edgesInCsr);
+	m_edgePool.swap(graph.m_edgePool);
+	m_dataPool.swap(graph.m_dataPool);
+	std::swap(m_table, graph.m_table);
+	m_rowSlot.swap(graph.m_rowSlot);
+	m_slotSource.swap(graph.m_slotSource);
+	m_slotVersion.swap(graph.m_slotVersion);
+	m_recentRows.swap(graph.m_recentRows);
+	m_recentPosition.swap(graph.m_recentPosition);
+	m_csr.swap(graph.m_csr);
+	m_reverseCsr.swap(graph.m_reverseCsr);
+	m_incoming.swap(graph.m_incoming);
+	std::swap(m_incomingVersion, graph.m_incomingVersion);
+	m_pool.swap(graph.m_pool);
+	std::swap(m_stats, graph.m_stats);
+}
+
+
 // copyVertices: copy constructor helper
 // copies all Vertex data in graph.m_vertices into m_vertices. creates new data
 // preconditions:	graph must be a valid Graph object (must not reference a
@@ -115,7 +505,7 @@ Graph::Graph(const Graph &graph) {
 //
 void Graph::copyVertices(const Graph &graph) {
 	for(int i = 0; i < m_size; i++) {
-		m_vertices[i] = Vertex(new GraphData(*graph.m_vertices[i].m_data));
+		m_vertices[i] = Vertex(m_dataPool.create(*graph.m_vertices[i].m_data));
 		copyEdge(m_vertices[i].m_edgeHead, graph.m_vertices[i].m_edgeHead);
 	}
 }
@@ -123,33 +513,37 @@ void Graph::copyVertices(const Graph &graph) {
 
 // copyEdge: copyVertives helper
 // to becomes a new Edge with m_weight, m_adjVertex, and m_nextEdge equal
-// to the corresponding values in from.
+// to the corresponding values in from. The list is copied in a loop, so
+// long lists cannot overflow the stack.
 // preconditions:	none
 // postconditions:	to becomes an identical copy of from
 //
 void Graph::copyEdge(Edge *&to, Edge *from) {
-	if(from == nullptr) {
-		to = nullptr;
-	} else {
-		to = new Edge(from->m_weight, from->m_adjVertex);
-		copyEdge(to->m_nextEdge, from->m_nextEdge);
+	Edge **tail = &to;
+	for(; from != nullptr; from = from->m_nextEdge) {
+		*tail = m_edgePool.create(from->m_weight, from->m_adjVertex);
+		tail = &(*tail)->m_nextEdge;
 	}
+	*tail = nullptr;
 }
 
 
 // copyTable: copy contructor helper
-// copies all data in graph.m_table to m_table
+// copies all rows in graph.m_table, and their slots, versions and order of
+// use, to m_table
 // preconditions:	graph must be a valid Graph object (must not reference a
 //					dereferenced nullptr)
 // postconditions:	m_table = graph.m_table
 //
 void Graph::copyTable(const Graph &graph) {
-	for(int i = 0; i < m_size; i++) {
-		for(int j = 0; j < m_size; j++) {
-			m_table[i][j].m_visited = graph.m_table[i][j].m_visited;
-			m_table[i][j].m_path = graph.m_table[i][j].m_path;
-			m_table[i][j].m_dist = graph.m_table[i][j].m_dist;
-		}
+	m_table = graph.m_table;
+	m_rowSlot = graph.m_rowSlot;
+	m_slotSource = graph.m_slotSource;
+	m_slotVersion = graph.m_slotVersion;
+	m_recentRows = graph.m_recentRows;
+	m_recentPosition.assign(m_size, m_recentRows.end());
+	for(list<int>::iterator i = m_recentRows.begin(); i != m_recentRows.end(); i++) {
+		m_recentPosition[*i] = i;
 	}
 }
 
@@ -164,23 +558,40 @@ Graph::~Graph() {
 }
 
 
+// edgesChanged
+// discards everything derived from the edges in m_vertices and starts a
+// new graph version
+// preconditions:	none
+// postconditions:	m_csr = nullptr; m_reverseCsr = nullptr; m_version is
+//					incremented
+//
+void Graph::edgesChanged() {
+	m_csr = nullptr;
+	m_reverseCsr = nullptr;
+	m_version++;
+}
+
+
 // empty
-// removes all data from m_vertices and sets all pointers to nullptr
+// removes all data from m_vertices and sets all pointers to nullptr. Edges
+// need no destructor, so they are returned with their pool's chunks rather
+// than one at a time; each GraphData is destroyed since it owns a string.
 // preconditions:	none
 // postconditions:	all data from m_vertices removed and pointers set to nullptr
 //
 void Graph::empty() {
 	for(int i = 0; i < m_size; i++) {
-		while(m_vertices[i].m_edgeHead != nullptr) {
-			Edge *del = m_vertices[i].m_edgeHead;
-			m_vertices[i].m_edgeHead = m_vertices[i].m_edgeHead->m_nextEdge;
-			delete del;
-			del = nullptr;
-		}
-		delete m_vertices[i].m_data;
+		m_dataPool.destroy(m_vertices[i].m_data);
 		m_vertices[i].m_data = nullptr;
+		m_vertices[i].m_edgeHead = nullptr;
 	}
+	m_edgePool.release();
+	m_dataPool.release();
+	m_vertices.clear();
+	m_edgesInCsr = false;
 	m_size = 0;
+	resetTable();
+	edgesChanged();
 }
 
 
@@ -192,17 +603,22 @@ void Graph::empty() {
 //					set with the data and edges read in from inFile.
 //
 void Graph::buildGraph(ifstream &infile) {
-	infile >> m_size; // data member stores array size
-	if (infile.eof() || m_size > MAX_VERTICES) {
+	empty();
+	int size = 0;
+	infile >> size;
+	if (infile.eof() || size <= 0) {
 		return;
 	}
 	infile.ignore(); // throw away '\n' go to next line
+	m_size = size; // data member stores array size
+	m_vertices.resize(m_size);
+	resetTable();
 	
 	// get descriptions of vertices
 	for (int i = 0; i < m_size; i++) {
 		string name = "";	
 		getline(infile, name, '\n'); 
-		m_vertices[i] = Vertex(new GraphData(name));
+		m_vertices[i] = Vertex(readData(name));
 	}
 
 	// fill cost edge array
@@ -217,6 +633,190 @@ void Graph::buildGraph(ifstream &infile) {
 }
 
 
+// buildGraph(GraphLoader&)
+// reads graph information from loader and sets this to the corresponding
+// values, then calls loader.finish() so its stats cover the whole build.
+// precondition:	loader must be open on a file properly formated to the
+//					specifications in HW3.pdf and not yet read from.
+// postconditions:	m_size set to the size read in from loader. m_vertices
+//					set with the data and edges read in from loader.
+//
+void Graph::buildGraph(GraphLoader &loader) {
+	empty();
+	int size = 0;
+	if(!loader.readSize(size) || size <= 0) {
+		loader.finish();
+		return;
+	}
+	m_size = size;
+	m_vertices.resize(m_size);
+	resetTable();
+
+	// get descriptions of vertices
+	string name;
+	for(int i = 0; i < m_size; i++) {
+		loader.readLine(name);
+		m_vertices[i] = Vertex(readData(name));
+	}
+
+	// fill cost edge array. m_table is empty, so there is nothing to update
+	// after each edge; the graph version changes once at the end instead.
+	int src = 0, dest = 0, cost = 0;
+	while(loader.readEdge(src, dest, cost)) {
+		if(src >= 1 && src <= m_size && dest >= 1 && dest <= m_size &&
+			cost >= 0 && src != dest) {
+			insertEdge(dest, cost, m_vertices[src - 1]);
+		}
+	}
+	edgesChanged();
+	loader.finish();
+}
+
+
+// buildGraph(vector<string>, const EdgeTriple*, int)
+// sets this to a graph with one vertex for each line of titles, which are
+// read like the vertex description lines of a file, and the count edges
+// in edges, loaded with insertEdges(...)
+// preconditions:	edges holds count triples
+// postconditions:	m_size = titles.size(); m_vertices set with the data in
+//					titles and the edges in edges
+//
+void Graph::buildGraph(const vector<string> &titles, const EdgeTriple *edges,
+	int count) {
+	empty();
+	if(titles.empty()) {
+		return;
+	}
+	m_size = static_cast<int>(titles.size());
+	m_vertices.resize(m_size);
+	resetTable();
+
+	for(int i = 0; i < m_size; i++) {
+		m_vertices[i] = Vertex(readData(titles[i]));
+	}
+	insertEdges(edges, count);
+}
+
+
+// writeFile
+// saves the vertices and edges of this graph to fileName as a GraphFile,
+// along with every current row of m_table if includeTable is true
+// preconditions:	none
+// postconditions:	returns true if fileName was written completely
+//
+bool Graph::writeFile(const string &fileName, bool includeTable) const {
+	vector<const GraphData*> data(m_size);
+	for(int i = 0; i < m_size; i++) {
+		data[i] = m_vertices[i].m_data;
+	}
+	vector<int> rowSources, rowDist, rowPred;
+	if(includeTable) {
+		for(int source = 0; source < m_size; source++) {
+			if(!isCurrent(source)) {
+				continue;
+			}
+			rowSources.push_back(source);
+			const int *dist = distRow(source);
+			rowDist.insert(rowDist.end(), dist, dist + m_size);
+			for(int i = 0; i < m_size; i++) {
+				rowPred.push_back(dist[i] == INFINITY ? -1 : getPred(source, i));
+			}
+		}
+	}
+	return(GraphFile::write(fileName, *getCsr(), data, rowSources, rowDist, 
+		rowPred));
+}
+
+
+// openFile
+// replaces this graph with the one saved in fileName by writeFile. The 
+// edges are read in place from the mapped file and any saved rows of
+// m_table, up to the row limit, are current again.
+// preconditions:	none
+// postconditions:	returns true and sets m_size, m_vertices and m_csr 
+//					from fileName if it is a valid GraphFile; otherwise
+//					returns false and this graph is unchanged
+//
+bool Graph::openFile(const string &fileName) {
+	GraphFile file(fileName);
+	if(!file.isOpen()) {
+		return(false);
+	}
+	empty();
+	m_size = file.getSize();
+	m_vertices.resize(m_size);
+	resetTable();
+	for(int i = 0; i < m_size; i++) {
+		m_vertices[i] = Vertex(m_dataPool.create(file.getData(i)));
+	}
+	m_csr = file.getCsr();
+	m_edgesInCsr = true;
+
+	for(int row = 0; row < file.getRowCount() && 
+		static_cast<int>(m_slotSource.size()) < rowCapacity(); row++) {
+		int source = file.getRowSource(row);
+		if(m_rowSlot[source] != -1) {
+			continue;
+		}
+		assignSlot(source);
+		const int *dist = file.getRowDist(row);
+		const int *pred = file.getRowPred(row);
+		copy(dist, dist + m_size, distRow(source));
+		for(int i = 0; i < m_size; i++) {
+			if(dist[i] != INFINITY) {
+				setPred(source, i, pred[i]);
+			}
+		}
+		m_slotVersion[m_rowSlot[source]] = m_version;
+	}
+	return(true);
+}
+
+
+// loadEdges
+// builds the Edge linked lists in m_vertices from m_csr after openFile
+// preconditions:	m_edgesInCsr is true, so m_csr holds every edge
+// postconditions:	m_vertices holds every edge in m_csr, in the same
+//					order; m_edgesInCsr = false
+//
+void Graph::loadEdges() {
+	const int *offsets = m_csr->getOffsets();
+	const int *adjVertices = m_csr->getAdjVertices();
+	const int *weights = m_csr->getWeights();
+	for(int u = 0; u < m_size; u++) {
+		Edge **tail = &m_vertices[u].m_edgeHead;
+		for(int i = offsets[u]; i < offsets[u + 1]; i++) {
+			*tail = m_edgePool.create(weights[i], adjVertices[i]);
+			tail = &(*tail)->m_nextEdge;
+		}
+	}
+	m_edgesInCsr = false;
+}
+
+
+// readData: buildGraph helper
+// creates the GraphData for one vertex description line. A line ending in
+// "@ x y" gives the vertex coordinates; the title is the text before '@'.
+// preconditions:	none
+// postconditions:	returns a new GraphData for line
+//
+GraphData *Graph::readData(const string &line) {
+	size_t at = line.rfind('@');
+	if(at != string::npos) {
+		istringstream coordinates(line.substr(at + 1));
+		double x = 0, y = 0;
+		string extra;
+		if(coordinates >> x >> y && !(coordinates >> extra)) {
+			string title = line.substr(0, at);
+			size_t end = title.find_last_not_of(" \t");
+			title = (end == string::npos) ? "" : title.substr(0, end + 1);
+			return(m_dataPool.create(title, x, y));
+		}
+	}
+	return(m_dataPool.create(line));
+}
+
+
 // insertEdge
 // inserts an edge into m_vertices[source]'s edge linked list with m_weight
 // equal to cost and m_adjVertex equal to dest. If an edge from source to 
@@ -232,35 +832,131 @@ void Graph::insertEdge(int source, int dest, int cost) {
 		cost < 0 || source == dest) {
 		return;
 	}
-	insertEdge(dest, cost, m_vertices[source - 1].m_edgeHead);
+	if(m_edgesInCsr) {
+		loadEdges();
+	}
+	int oldCost = findWeight(source - 1, dest - 1);
+	insertEdge(dest, cost, m_vertices[source - 1]);
+	edgesChanged();
+	updateTable(source - 1, dest - 1, oldCost, cost);
 }
 
 
 // insertEdge helper
-// inserts an edge into m_vertices[]'s edge linked list with m_weight
-// equal to cost and m_adjVertex equal to dest. If an edge from source to 
-// dest already exists, than that edge's m_weight is set to cost.
-// preconditions:	source and dest must be the numerical-order value of the
-//					edge's they represent (not the index value)
+// inserts an edge into vertex's edge linked list with m_weight equal to 
+// cost and m_adjVertex equal to dest. If an edge from vertex to dest 
+// already exists, than that edge's m_weight is set to cost.
+// preconditions:	dest must be the numerical-order value of the vertex it
+//					represents (not the index value)
 // postconditions:	a new Edge with m_weight = cost and m_adjVertex = dest is
-//					inserted into m_vertices[]'s edge linked list
+//					appended to vertex's edge linked list
 //
-void Graph::insertEdge(int dest, int cost, Edge *&edge) { 
+void Graph::insertEdge(int dest, int cost, Vertex &vertex) { 
 	if(dest < 0 || dest > m_size || cost < 0) {
 		return;
 	}
 
-	if(edge == nullptr) {
-		edge = new Edge(cost, dest - 1);
+	Edge **link = findLink(vertex, dest - 1);
+	if(*link != nullptr) {
+		(*link)->m_weight = cost;
 		return;
 	}
+	*link = m_edgePool.create(cost, dest - 1);
+	EdgeIndex &index = vertex.m_edgeIndex;
+	if(index.isBuilt()) {
+		index.insert(dest - 1, index.m_lastEdge);
+		index.m_lastEdge = *link;
+	}
+}
 
-	if(edge->m_adjVertex == dest - 1) {
-		edge->m_weight = cost;
-		return;
+
+// findLink
+// returns the link, either vertex.m_edgeHead or some Edge's m_nextEdge, 
+// that points to vertex's Edge to adj, or the nullptr link at the end of 
+// the list if there is none. The list is walked until it reaches 
+// EDGE_INDEX_MIN Edges; from then on its EdgeIndex is used.
+// preconditions:	adj must be an index value
+// postconditions:	returns the link; vertex.m_edgeIndex is built if the 
+//					list has at least EDGE_INDEX_MIN Edges
+//
+Graph::Edge **Graph::findLink(Vertex &vertex, int adj) {
+	EdgeIndex &index = vertex.m_edgeIndex;
+	if(!index.isBuilt()) {
+		int length = 0;
+		Edge **link = &vertex.m_edgeHead;
+		while(*link != nullptr && (*link)->m_adjVertex != adj) {
+			link = &(*link)->m_nextEdge;
+			length++;
+		}
+		if(length < EDGE_INDEX_MIN) {
+			return(link);
+		}
+		index.build(vertex.m_edgeHead);
 	}
 
-	insertEdge(dest, cost, edge->m_nextEdge);
+	int slot = index.find(adj);
+	Edge *prevEdge = (slot == -1) ? index.m_lastEdge : index.m_prevEdges[slot];
+	return((prevEdge == nullptr) ? &vertex.m_edgeHead : &prevEdge->m_nextEdge);
+}
+
+
+// sortBySource: insertEdges helper
+// sorts the valid triples in edges by source with a stable counting sort.
+// Each of up to m_threadCount threads counts the sources in one chunk of
+// edges, and then places that chunk's triples after those of every earlier
+// chunk with the same source, so triples with the same source stay in 
+// the order given.
+// preconditions:	edges holds count triples
+// postconditions:	offsets holds m_size + 1 entries; edges[order[i]] for i
+//					from offsets[v] through offsets[v + 1] - 1 are the valid
+//					triples from index value v, in the order given
+//
+void Graph::sortBySource(const EdgeTriple *edges, int count, 
+	vector<int> &offsets, vector<int> &order) const {
+	int chunks = (m_threadCount < count) ? m_threadCount : count;
+	int chunkSize = (count + chunks - 1) / chunks;
+	auto isValid = [this](const EdgeTriple &triple) {
+		return(triple.m_source >= 1 && triple.m_source <= m_size &&
+			triple.m_dest >= 1 && triple.m_dest <= m_size &&
+			triple.m_cost >= 0 && triple.m_source != triple.m_dest);
+	};
+
+	// position[c * m_size + v] counts, then places, chunk c's triples from v
+	vector<int> position(static_cast<size_t>(chunks) * m_size, 0);
+	ThreadPool pool(chunks);
+	pool.parallelFor(chunks, [&](int chunk, int) {
+		int *counts = &position[static_cast<size_t>(chunk) * m_size];
+		int end = min(count, (chunk + 1) * chunkSize);
+		for(int i = chunk * chunkSize; i < end; i++) {
+			if(isValid(edges[i])) {
+				counts[edges[i].m_source - 1]++;
+			}
+		}
+	});
+
+	offsets.assign(m_size + 1, 0);
+	int next = 0;
+	for(int v = 0; v < m_size; v++) {
+		offsets[v] = next;
+		for(int chunk = 0; chunk < chunks; chunk++) {
+			int &at = position[static_cast<size_t>(chunk) * m_size + v];
+			int chunkCount = at;
+			at = next;
+			next += chunkCount;
+		}
+	}
+	offsets[m_size] = next;
+
+	order.resize(next);
+	pool.parallelFor(chunks, [&](int chunk, int) {
+		int *at = &position[static_cast<size_t>(chunk) * m_size];
+		int end = min(count, (chunk + 1) * chunkSize);
+		for(int i = chunk * chunkSize; i < end; i++) {
+			if(isValid(edges[i])) {
+				order[at[edges[i].m_source - 1]++] = i;
+			}
+		}
+	});
 }
 
 
@@ -272,151 +968,1447 @@ void Graph::insertEdge(int dest, int cost, Edge *&edge) {
 //					is removed, if it exists
 //
 void Graph::removeEdge(int source, int dest) {
-	if(source < 1 || source > m_size ||
-		dest < 1 || dest > m_size ||
-		m_vertices[source - 1].m_edgeHead == nullptr) {
+	if(source < 1 || source > m_size || dest < 1 || dest > m_size) {
 		return;
 	}
-	
-	if(m_vertices[source - 1].m_edgeHead->m_adjVertex == dest - 1) {
-		Edge *del = m_vertices[source - 1].m_edgeHead;
-		m_vertices[source - 1].m_edgeHead = m_vertices[source - 1].m_edgeHead->m_nextEdge;
-		delete del;
-		del = nullptr;
+	if(m_edgesInCsr) {
+		loadEdges();
+	}
+	if(m_vertices[source - 1].m_edgeHead == nullptr) {
 		return;
 	}
 
-	Edge *temp = m_vertices[source - 1].m_edgeHead;
-	while(temp->m_nextEdge != nullptr) {
-		if(temp->m_nextEdge->m_adjVertex == dest - 1) {
-			Edge *del = temp->m_nextEdge;
-			temp->m_nextEdge = temp->m_nextEdge->m_nextEdge;
-			delete del;
-			del = nullptr;
-			return;
-		}
-		temp = temp->m_nextEdge;
+	Vertex &vertex = m_vertices[source - 1];
+	Edge **link = findLink(vertex, dest - 1);
+	if(*link == nullptr) {
+		return;
 	}
-}
 
-
-// findShortestPath
-// set m_table with the appropriate values of the shortest paths between
-// each vertex, corresponding to the contents of m_vertices.
-// preconditions:	buildGraph has been called or m_size and m_vertices are
-//					all set with valid information
-// postconditions:	m_table's fields are set to the values corresponding to
-//					the shortest path's between vertices
-//
-void Graph::findShortestPath() {
-	resetTable();
-	for(int i = 0; i < m_size; i++) {
-		findShortestPath(i);
+	// the Edge after del, if any, now follows del's previous Edge
+	Edge *del = *link;
+	EdgeIndex &index = vertex.m_edgeIndex;
+	if(index.isBuilt()) {
+		int slot = index.find(dest - 1);
+		Edge *prevEdge = index.m_prevEdges[slot];
+		index.erase(slot);
+		if(del->m_nextEdge != nullptr) {
+			index.m_prevEdges[index.find(del->m_nextEdge->m_adjVertex)] = prevEdge;
+		} else {
+			index.m_lastEdge = prevEdge;
+		}
 	}
+	int oldCost = del->m_weight;
+	*link = del->m_nextEdge;
+	m_edgePool.destroy(del);
+	del = nullptr;
+	edgesChanged();
+	updateTable(source - 1, dest - 1, oldCost, INFINITY);
 }
 
 
-// findShortestPath helper
-// set m_table with the appropriate values of the shortest paths between
-// each vertex, corresponding to the contents of m_vertices.
-// preconditions:	buildGraph has been called or m_size and m_vertices are
-//					all set with valid information
-// postconditions:	m_table's fields are set to the values corresponding to
-//					the shortest path's between vertices
+// insertEdges
+// inserts the count edges in edges, leaving the graph as calling 
+// insertEdge(int, int, int) for each triple in order would: invalid 
+// triples are ignored, and when several triples share a source and dest,
+// the last one's cost replaces the cost of any existing edge. Instead of a
+// search of the edge list per triple, the triples are bucketed by source 
+// with a counting sort, spread across m_threadCount threads, and each 
+// source's list is then extended in one pass, so the cost is linear in 
+// count plus the length of the lists touched. m_table is not updated edge 
+// by edge; any row current before the call is computed again when next 
+// used.
+// preconditions:	edges holds count triples
+// postconditions:	every valid triple's edge is in the graph, with the cost
+//					of the last triple given for its source and dest
 //
-void Graph::findShortestPath(int source) {
-	if(source < 0 || source > m_size) {
+void Graph::insertEdges(const EdgeTriple *edges, int count) {
+	if(m_size == 0 || count <= 0) {
 		return;
 	}
-	setSource(source);
-	
-	// find shortest path for all vertices
-	for(int i = 0; i < m_size; i++) {
-		int lowestMove = findLowestMove(source);
-		if(lowestMove != INFINITY) {
-			visitVertex(source, lowestMove);
-		}
+	if(m_edgesInCsr) {
+		loadEdges();
 	}
-}
-
 
-// findLowestMove
-// finds the next shortest path in m_table
-// preconditions:	source must be the index value of the desired source vertex
-// postconditions:	returns an in representing the shortest path in m_table
-//
-int Graph::findLowestMove(int source) const {
-	int indexOfLowest = INFINITY;
-	int lowestWeight = INFINITY;
-	for(int i = 0; i < m_size - 1; i++) {
-		if(!m_table[source][i].m_visited && m_table[source][i].m_dist < lowestWeight) {
-			lowestWeight = m_table[source][i].m_dist;
-			indexOfLowest = i;
+	// edges[order[i]] for i from offsets[v] through offsets[v + 1] - 1 are
+	// the valid triples from index value v, in the order given
+	vector<int> offsets;
+	vector<int> order;
+	sortBySource(edges, count, offsets, order);
+
+	// edgeTo[dest] is the Edge to dest in the list being extended
+	vector<Edge *> edgeTo(m_size, nullptr);
+	for(int v = 0; v < m_size; v++) {
+		if(offsets[v] == offsets[v + 1]) {
+			continue;
 		}
-	}
-	return(indexOfLowest);
-}
 
+		Vertex &vertex = m_vertices[v];
+		Edge **tail = &vertex.m_edgeHead;
+		for(; *tail != nullptr; tail = &(*tail)->m_nextEdge) {
+			edgeTo[(*tail)->m_adjVertex] = *tail;
+		}
+		for(int i = offsets[v]; i < offsets[v + 1]; i++) {
+			const EdgeTriple &triple = edges[order[i]];
+			Edge *&edge = edgeTo[triple.m_dest - 1];
+			if(edge != nullptr) {
+				edge->m_weight = triple.m_cost;
+			} else {
+				edge = m_edgePool.create(triple.m_cost, triple.m_dest - 1);
+				*tail = edge;
+				tail = &edge->m_nextEdge;
+			}
+		}
+		for(Edge *edge = vertex.m_edgeHead; edge != nullptr; edge = edge->m_nextEdge) {
+			edgeTo[edge->m_adjVertex] = nullptr;
+		}
 
-// setSource
-// sets the source vetex's values and nest shortest paths in m_table.
-// preconditions:	source must be the index value of the desired source vertex
-// postconditions:	m_table[source][source].m_visited = true, 
-//					m_table[source][source].m_path = 0,
-//					m_table[source][source].m_dist = 0. 
-//
-void Graph::setSource(int source) {
-	m_table[source][source].m_path = 0;
-	m_table[source][source].m_dist = 0;
-	visitVertex(source, source);
+		// the index is built again the next time the list is searched
+		vertex.m_edgeIndex = EdgeIndex();
+	}
+	edgesChanged();
 }
 
 
-// visitVertex
-// marks m_table[source][dest].m_visited as true and sets any new shortest
-// paths in m_table
-// preconditions:	source and dest must be the index value of the desired 
+// findWeight
+// returns the weight of the edge from source to dest
+// preconditions:	source and dest must be the index values of the desired
 //					vertices
-// postconditions:	m_table[source][dest].m_visited = true; any new shortest
-//					paths set in m_table
+// postconditions:	returns the edge's m_weight, or INFINITY if there is no
+//					edge from source to dest
 //
-void Graph::visitVertex(int source, int dest) {
-	m_table[source][dest].m_visited = true;
-
-	Edge* edge_ptr = m_vertices[dest].m_edgeHead;
-	while(edge_ptr != nullptr) {
-		if(!m_table[source][edge_ptr->m_adjVertex].m_visited) {
-			if(m_table[source][edge_ptr->m_adjVertex].m_path == INFINITY ||
-				m_table[source][edge_ptr->m_adjVertex].m_dist > m_table[source][dest].m_dist + edge_ptr->m_weight) {
-				m_table[source][edge_ptr->m_adjVertex].m_path = dest + 1;
-				m_table[source][edge_ptr->m_adjVertex].m_dist = m_table[source][dest].m_dist + edge_ptr->m_weight;
-			}
+int Graph::findWeight(int source, int dest) const {
+	const EdgeIndex &index = m_vertices[source].m_edgeIndex;
+	if(index.isBuilt()) {
+		int slot = index.find(dest);
+		if(slot == -1) {
+			return(INFINITY);
+		}
+		Edge *prevEdge = index.m_prevEdges[slot];
+		return((prevEdge == nullptr) ? m_vertices[source].m_edgeHead->m_weight :
+			prevEdge->m_nextEdge->m_weight);
+	}
+	for(Edge *edge = m_vertices[source].m_edgeHead; edge != nullptr; edge = edge->m_nextEdge) {
+		if(edge->m_adjVertex == dest) {
+			return(edge->m_weight);
 		}
-		edge_ptr = edge_ptr->m_nextEdge;
 	}
+	return(INFINITY);
 }
 
 
-// resetTable
-// for all cells in m_table, sets m_visited to false, and m_path and m_dist
-// to INFINITY
-// preconditions:	none
-// postconditions:	for all cells in m_table, m_visited = false, m_path = 
-//					INFINITY, m_dist = INFINITY
+// updateTable
+// brings m_table up to date after the edge from source to dest changed 
+// from oldCost to newCost (INFINITY meaning no edge) and m_version was 
+// incremented. Every row that was current before the change and that the
+// change cannot affect is restamped with m_version. Affected rows are
+// repaired and restamped if incremental repair is on, otherwise they are
+// left out of date. The repairs run on m_threadCount threads only when 
+// at least REPAIR_PARALLEL_MIN rows are affected, since starting the 
+// threads costs more than a few repairs. They read the Edge lists in 
+// m_vertices and the incoming edges in m_incoming, which is patched for
+// the changed edge rather than rebuilt, so neither m_csr nor 
+// m_reverseCsr is rebuilt for them.
+// preconditions:	source and dest must be the index values of the changed
+//					edge's vertices. The Edge lists in m_vertices hold the
+//					edges after the change.
+// postconditions:	every row current before the change is current again,
+//					except affected rows when incremental repair is off
 //
-void Graph::resetTable() {
-	for(int i = 0; i < MAX_VERTICES; i++) {
-		for(int j = 0; j < MAX_VERTICES; j++) {
-			m_table[i][j].m_visited = false;
-			m_table[i][j].m_path = INFINITY;
-			m_table[i][j].m_dist = INFINITY;
-		}
+void Graph::updateTable(int source, int dest, int oldCost, int newCost) {
+	// m_incoming only lacks this change if it matched the edges before it
+	if(m_incomingVersion == m_version - 1) {
+		patchIncoming(source, dest, newCost);
+		m_incomingVersion = m_version;
+	}
+
+	// checking a row takes constant time, so it is never worth a thread
+	vector<int> affected;
+	for(size_t slot = 0; slot < m_slotSource.size(); slot++) {
+		int row = m_slotSource[slot];
+		if(row == -1 || m_slotVersion[slot] != m_version - 1) {
+			continue;
+		}
+		if(isAffected(row, source, dest, oldCost, newCost)) {
+			affected.push_back(row);
+		} else {
+			m_slotVersion[slot] = m_version;
+		}
+	}
+	if(!m_incrementalRepair || affected.empty()) {
+		return;
+	}
+
+	// build m_incoming before any thread starts reading it
+	if(m_incomingVersion != m_version) {
+		buildIncoming();
+	}
+
+	// every row is repaired independently of the others
+	int count = static_cast<int>(affected.size());
+	auto repair = [&](int i, int) {
+		int row = affected[i];
+		if(newCost < oldCost) {
+			repairDecrease(row, source, dest, newCost);
+		} else {
+			repairIncrease(row, source, dest);
+		}
+		m_slotVersion[m_rowSlot[row]] = m_version;
+	};
+	if(m_threadCount == 1 || count < REPAIR_PARALLEL_MIN) {
+		for(int i = 0; i < count; i++) {
+			repair(i, 0);
+		}
+		return;
+	}
+	getPool().parallelFor(count, repair);
+}
+
+
+// isAffected: updateTable helper
+// returns true if changing the edge from -> to from oldCost to newCost 
+// can change row's distances or predecessors
+// preconditions:	row, from and to must be index values. row is current
+//					for the edges before the change.
+// postconditions:	returns true if row must be repaired or recomputed
+//
+bool Graph::isAffected(int row, int from, int to, int oldCost, int newCost) const {
+	const int *dist = distRow(row);
+	if(oldCost == newCost) {
+		return(false);
+	}
+	if(newCost < oldCost) {
+		return(dist[from] != INFINITY && Traits::add(dist[from], newCost) < dist[to]);
+	}
+	return(dist[to] != INFINITY && to != row && getPred(row, to) == from);
+}
+
+
+// repairDecrease: updateTable helper
+// repairs row of m_table after the edge from -> to was added or made
+// cheaper with weight cost. Starting at to, only vertices whose distance
+// becomes shorter are revisited, through the Edge lists in m_vertices.
+// preconditions:	row, from and to must be index values. row is current
+//					for the edges before the change. The Edge lists hold
+//					the edges after the change.
+// postconditions:	row is current for the edges after the change
+//
+void Graph::repairDecrease(int row, int from, int to, int cost) {
+	int *dist = distRow(row);
+	if(dist[from] == INFINITY || Traits::add(dist[from], cost) >= dist[to]) {
+		return;
+	}
+
+	MinHeap heap;
+	setPred(row, to, from);
+	dist[to] = Traits::add(dist[from], cost);
+	heap.push(make_pair(dist[to], to));
+	while(!heap.empty()) {
+		int vertexDist = heap.top().first;
+		int vertex = heap.top().second;
+		heap.pop();
+		if(vertexDist > dist[vertex]) {
+			continue;
+		}
+
+		for(Edge *edge = m_vertices[vertex].m_edgeHead; edge != nullptr; 
+			edge = edge->m_nextEdge) {
+			int adj = edge->m_adjVertex;
+			int adjDist = Traits::add(vertexDist, edge->m_weight);
+			if(adjDist < dist[adj]) {
+				setPred(row, adj, vertex);
+				dist[adj] = adjDist;
+				heap.push(make_pair(dist[adj], adj));
+			}
+		}
+	}
+}
+
+
+// repairIncrease: updateTable helper
+// repairs row of m_table after the edge from -> to was removed or made 
+// more expensive. If the edge is on row's shortest path to to, every 
+// vertex whose path passes through it is reset and searched again from
+// its unaffected neighbors, found in m_incoming.
+// preconditions:	row, from and to must be index values. row is current
+//					for the edges before the change. The Edge lists and 
+//					m_incoming hold the edges after the change.
+// postconditions:	row is current for the edges after the change
+//
+void Graph::repairIncrease(int row, int from, int to) {
+	int *dist = distRow(row);
+	if(dist[to] == INFINITY || to == row || getPred(row, to) != from) {
+		return;
+	}
+
+	// collect the subtree of the shortest path tree hanging below to
+	vector<int> firstChild(m_size, -1);
+	vector<int> nextSibling(m_size, -1);
+	for(int i = 0; i < m_size; i++) {
+		if(dist[i] != INFINITY && i != row) {
+			int parent = getPred(row, i);
+			nextSibling[i] = firstChild[parent];
+			firstChild[parent] = i;
+		}
+	}
+	vector<int> affected(1, to);
+	for(size_t i = 0; i < affected.size(); i++) {
+		for(int child = firstChild[affected[i]]; child != -1; child = nextSibling[child]) {
+			affected.push_back(child);
+		}
+	}
+	for(size_t i = 0; i < affected.size(); i++) {
+		dist[affected[i]] = INFINITY;
+	}
+
+	// seed each affected vertex with its best edge from an unaffected vertex
+	MinHeap heap;
+	for(size_t i = 0; i < affected.size(); i++) {
+		int vertex = affected[i];
+		const vector<pair<int, int> > &incoming = m_incoming[vertex];
+		for(size_t j = 0; j < incoming.size(); j++) {
+			int pred = incoming[j].first;
+			int predDist = Traits::add(dist[pred], incoming[j].second);
+			if(predDist < dist[vertex]) {
+				setPred(row, vertex, pred);
+				dist[vertex] = predDist;
+			}
+		}
+		if(dist[vertex] != INFINITY) {
+			heap.push(make_pair(dist[vertex], vertex));
+		}
+	}
+
+	// settle the affected vertices; unaffected distances cannot shrink, and
+	// a vertex is only pushed when its distance strictly improves, so each
+	// vertex is settled once without a visited mark
+	while(!heap.empty()) {
+		int vertexDist = heap.top().first;
+		int vertex = heap.top().second;
+		heap.pop();
+		if(vertexDist > dist[vertex]) {
+			continue;
+		}
+
+		for(Edge *edge = m_vertices[vertex].m_edgeHead; edge != nullptr; 
+			edge = edge->m_nextEdge) {
+			int adj = edge->m_adjVertex;
+			int adjDist = Traits::add(vertexDist, edge->m_weight);
+			if(adjDist < dist[adj]) {
+				setPred(row, adj, vertex);
+				dist[adj] = adjDist;
+				heap.push(make_pair(dist[adj], adj));
+			}
+		}
+	}
+}
+
+
+// buildIncoming: updateTable helper
+// fills m_incoming from the Edge lists in m_vertices
+// preconditions:	the Edge lists hold every edge (m_edgesInCsr is false)
+// postconditions:	m_incoming[v] holds every edge into v; m_incomingVersion
+//					= m_version
+//
+void Graph::buildIncoming() {
+	m_incoming.assign(m_size, vector<pair<int, int> >());
+	for(int i = 0; i < m_size; i++) {
+		for(Edge *edge = m_vertices[i].m_edgeHead; edge != nullptr; 
+			edge = edge->m_nextEdge) {
+			m_incoming[edge->m_adjVertex].push_back(make_pair(i, edge->m_weight));
+		}
+	}
+	m_incomingVersion = m_version;
+}
+
+
+// patchIncoming: updateTable helper
+// changes the weight of the edge from -> to in m_incoming to newCost, 
+// adding the edge if it is missing or removing it if newCost is INFINITY
+// preconditions:	from and to must be index values
+// postconditions:	m_incoming[to] holds (from, newCost) once, or no entry
+//					from from if newCost is INFINITY
+//
+void Graph::patchIncoming(int from, int to, int newCost) {
+	vector<pair<int, int> > &incoming = m_incoming[to];
+	size_t i = 0;
+	while(i < incoming.size() && incoming[i].first != from) {
+		i++;
+	}
+	if(newCost == INFINITY) {
+		if(i < incoming.size()) {
+			incoming[i] = incoming.back();
+			incoming.pop_back();
+		}
+	} else if(i < incoming.size()) {
+		incoming[i].second = newCost;
+	} else {
+		incoming.push_back(make_pair(from, newCost));
+	}
+}
+
+
+// findShortestPath
+// set m_table with the appropriate values of the shortest paths between
+// each vertex, corresponding to the contents of m_vertices. Sources are
+// handed out to m_threadCount threads, or, for FLOYD_WARSHALL, blocks of
+// the table are; DELTA_STEPPING runs the sources one after another, each 
+// on every thread. If a row limit smaller than the number of vertices is
+// set, only the rows already in m_table are recomputed and the rest are
+// left to be computed on demand.
+// preconditions:	buildGraph has been called or m_size and m_vertices are
+//					all set with valid information
+// postconditions:	m_table's fields are set to the values corresponding to
+//					the shortest path's between vertices
+//
+void Graph::findShortestPath() {
+	getCsr();	// build m_csr before the threads start reading it
+	if(usesFloydWarshall()) {
+		findShortestPathFloyd();
+		return;
+	}
+
+	// give every source a slot while there is room, without evicting
+	vector<int> sources;
+	for(int i = 0; i < m_size; i++) {
+		if(m_rowSlot[i] == -1 && static_cast<int>(m_slotSource.size()) < rowCapacity()) {
+			assignSlot(i);
+		}
+		if(m_rowSlot[i] != -1) {
+			sources.push_back(i);
+		}
+	}
+
+	// DELTA_STEPPING already uses every thread within each search
+	if(m_engine == DELTA_STEPPING) {
+		for(size_t i = 0; i < sources.size(); i++) {
+			findShortestPath(sources[i]);
+		}
+		return;
+	}
+
+	// every source writes only to its own row of m_table
+	int count = static_cast<int>(sources.size());
+	getPool().parallelFor(count, [this, &sources](int i, int) {
+		findShortestPath(sources[i]);
+	});
+}
+
+
+// findShortestPath helper
+// set source's row of m_table with the appropriate values of the shortest
+// paths from source, corresponding to the contents of m_vertices. 
+// DELTA_STEPPING runs the search on the threads of getPool().
+// preconditions:	source must be the index value of a vertex with a slot
+//					in m_table. m_csr must be current. For DELTA_STEPPING, 
+//					it is not called from a task running on getPool().
+// postconditions:	source's row is reset, then set to the values 
+//					corresponding to the shortest paths from source
+//
+void Graph::findShortestPath(int source) const {
+	if(source < 0 || source >= m_size) {
+		return;
+	}
+	GRAPH_STATS_START();
+	resetRow(source);
+	GRAPH_STATS_LAP(m_resetSeconds);
+
+	if(m_engine == DELTA_STEPPING) {
+		findShortestPathDelta(source, getPool());
+	} else if(m_engine == BUCKET_QUEUE && m_csr->getMaxWeight() <= BUCKET_LIMIT) {
+		BucketQueue queue(m_csr->getMaxWeight());
+		findShortestPathQueue(source, queue);
+	} else if(m_engine != LINEAR_SCAN) {
+		MinHeap heap;
+		findShortestPathQueue(source, heap);
+	} else {
+		setSource(source);
+
+		// find shortest path for all vertices; visited only lives as long
+		// as the search
+		vector<char> visited(m_size, 0);
+		for(int i = 0; i < m_size; i++) {
+			int lowestMove = findLowestMove(source, visited.data());
+			if(lowestMove != INFINITY) {
+				visited[lowestMove] = 1;
+				visitVertex<MinHeap>(source, lowestMove, nullptr);
+			}
+		}
+	}
+	m_slotVersion[m_rowSlot[source]] = m_version;
+	GRAPH_STATS_LAP(m_searchSeconds);
+	GRAPH_STATS_COUNT(m_rows, 1);
+	GRAPH_STATS_RECORD();
+}
+
+
+// getRow
+// returns source's row of m_table, computing it first if it is missing or
+// out of date, and marks it most recently used
+// preconditions:	source must be the index value of the desired source vertex
+// postconditions:	returns a pointer to the m_size distances of source's 
+//					row
+//
+const int *Graph::getRow(int source) const {
+	if(m_rowSlot[source] == -1) {
+		assignSlot(source);
+	} else {
+		m_recentRows.splice(m_recentRows.begin(), m_recentRows, m_recentPosition[source]);
+	}
+
+	if(!isCurrent(source)) {
+		getCsr();
+		findShortestPath(source);
+	}
+	return(distRow(source));
+}
+
+
+// isCurrent
+// returns true if source has a row in m_table that is current for m_version
+// preconditions:	source must be the index value of the desired source vertex
+// postconditions:	returns true if source's row is cached and current
+//
+bool Graph::isCurrent(int source) const {
+	return(m_rowSlot[source] != -1 && m_slotVersion[m_rowSlot[source]] == m_version);
+}
+
+
+// assignSlot
+// gives source a slot in m_table, evicting the least recently used row if
+// the row limit has been reached
+// preconditions:	source must be the index value of a vertex without a slot
+// postconditions:	source has a slot and is the most recently used row
+//
+void Graph::assignSlot(int source) const {
+	int slot = static_cast<int>(m_slotSource.size());
+	if(slot < rowCapacity()) {
+		m_slotSource.push_back(source);
+		m_slotVersion.push_back(0);		// never current
+		m_table.m_dist.resize(m_table.m_dist.size() + m_size);
+		if(m_size <= SMALL_PRED_LIMIT) {
+			m_table.m_smallPred.resize(m_table.m_smallPred.size() + m_size);
+		} else {
+			m_table.m_pred.resize(m_table.m_pred.size() + m_size);
+		}
+	} else {
+		slot = m_rowSlot[m_recentRows.back()];
+		evictRow();
+		m_slotSource[slot] = source;
+		m_slotVersion[slot] = 0;
+	}
+	m_rowSlot[source] = slot;
+	m_recentRows.push_front(source);
+	m_recentPosition[source] = m_recentRows.begin();
+}
+
+
+// evictRow
+// removes the least recently used row from m_table
+// preconditions:	m_recentRows is not empty
+// postconditions:	the least recently used source no longer has a slot
+//
+void Graph::evictRow() const {
+	int source = m_recentRows.back();
+	m_recentRows.pop_back();
+	m_recentPosition[source] = m_recentRows.end();
+	m_slotSource[m_rowSlot[source]] = -1;
+	m_rowSlot[source] = -1;
+}
+
+
+// rowCapacity
+// returns the most rows m_table may hold for the current m_size
+// preconditions:	none
+// postconditions:	returns m_size, or m_rowLimit if it is smaller and set
+//
+int Graph::rowCapacity() const {
+	return((m_rowLimit > 0 && m_rowLimit < m_size) ? m_rowLimit : m_size);
+}
+
+
+// findShortestPathQueue: findShortestPath helper
+// set m_table[source] with the shortest paths from source using queue, a
+// MinHeap or BucketQueue, to choose the next vertex to visit. Queue is a
+// template parameter so the search loop calls the queue directly.
+// preconditions:	source must be the index value of the desired source vertex.
+//					m_table[source] must be reset. queue is empty.
+// postconditions:	m_table[source]'s fields are set to the values corresponding
+//					to the shortest paths from source
+//
+template <typename Queue>
+void Graph::findShortestPathQueue(int source, Queue &queue) const {
+	const int *row = distRow(source);
+	setSource(source);
+	queue.push(make_pair(0, source));
+	GRAPH_STATS_COUNT(m_pushes, 1);
+
+	while(!queue.empty()) {
+		int dist = queue.top().first;
+		int vertex = queue.top().second;
+		queue.pop();
+		GRAPH_STATS_COUNT(m_pops, 1);
+
+		// skip entries left behind by a later, shorter push. A vertex is 
+		// only pushed when its distance strictly improves, so the entry
+		// matching its final distance is popped exactly once.
+		if(dist > row[vertex]) {
+			continue;
+		}
+		visitVertex(source, vertex, &queue);
+	}
+}
+
+
+// findShortestPathDelta: findShortestPath helper
+// set m_table[source] with the shortest paths from source by delta-stepping
+// on the threads of pool. Tentative distances live in an array of atomics
+// that any thread lowers with compare-and-swap. Vertices wait in buckets of
+// tentative distances delta wide; the lowest bucket is emptied in rounds 
+// that relax every edge of weight at most delta leaving its vertices in
+// parallel, and once it is empty the heavier edges of every vertex settled
+// in it are relaxed in parallel too. The predecessors are then set by 
+// setSettledPreds().
+// preconditions:	source must be the index value of the desired source vertex.
+//					m_table[source] must be reset. m_csr must be current.
+// postconditions:	m_table[source]'s fields are set to the values corresponding
+//					to the shortest paths from source, the same as 
+//					findShortestPathQueue(source, queue) sets
+//
+void Graph::findShortestPathDelta(int source, ThreadPool &pool) const {
+	int *row = distRow(source);
+	const int *offsets = m_csr->getOffsets();
+	const int *adjVertices = m_csr->getAdjVertices();
+	const int *weights = m_csr->getWeights();
+	int edgeCount = m_csr->getEdgeCount();
+
+	int maxWeight = 0;
+	bool zeroWeight = false;
+	for(int i = 0; i < edgeCount; i++) {
+		maxWeight = max(maxWeight, weights[i]);
+		zeroWeight = zeroWeight || weights[i] == 0;
+	}
+	int delta = m_deltaWidth;
+	if(delta < 1) {
+		long long width = static_cast<long long>(maxWeight) * m_size / max(edgeCount, 1);
+		delta = static_cast<int>(max(1LL, width));
+	}
+
+	vector<atomic<int> > tentative(m_size);
+	for(int i = 0; i < m_size; i++) {
+		tentative[i].store(INFINITY, memory_order_relaxed);
+	}
+	tentative[source].store(0, memory_order_relaxed);
+
+	// relaxedAt holds the distance each vertex last relaxed its edges from,
+	// so stale and repeated bucket entries are skipped. reached collects, 
+	// per thread, the vertices whose distance a step lowered.
+	vector<int> relaxedAt(m_size, INFINITY);
+	vector<vector<int> > reached(pool.getThreadCount());
+	map<int, vector<int> > buckets;
+	buckets[0].push_back(source);
+
+	// relax: lowers to's distance to dist if that is shorter
+	auto relax = [&tentative, &reached](int to, int dist, int thread) {
+		int old = tentative[to].load(memory_order_relaxed);
+		while(dist < old) {
+			if(tentative[to].compare_exchange_weak(old, dist, memory_order_relaxed)) {
+				reached[thread].push_back(to);
+				return;
+			}
+		}
+	};
+
+	// relaxEdges: relaxes the light or heavy edges of every vertex in 
+	// vertices, in parallel
+	auto relaxEdges = [&](const vector<int> &vertices, bool light) {
+		int count = static_cast<int>(vertices.size());
+		pool.parallelFor((count + DELTA_CHUNK - 1) / DELTA_CHUNK, [&](int chunk, int thread) {
+			int end = min(count, (chunk + 1) * DELTA_CHUNK);
+			for(int i = chunk * DELTA_CHUNK; i < end; i++) {
+				int from = vertices[i];
+				for(int j = offsets[from]; j < offsets[from + 1]; j++) {
+					if((weights[j] <= delta) == light) {
+						relax(adjVertices[j], Traits::add(relaxedAt[from], weights[j]), 
+							thread);
+					}
+				}
+			}
+		});
+	};
+
+	// fileReached: moves the vertices reached by the last step into the 
+	// bucket of their new distance, or into frontier if that is bucket
+	auto fileReached = [&](int bucket, vector<int> &frontier) {
+		for(size_t t = 0; t < reached.size(); t++) {
+			for(size_t i = 0; i < reached[t].size(); i++) {
+				int vertex = reached[t][i];
+				int index = tentative[vertex].load(memory_order_relaxed) / delta;
+				if(index == bucket) {
+					frontier.push_back(vertex);
+				} else {
+					buckets[index].push_back(vertex);
+				}
+			}
+			reached[t].clear();
+		}
+	};
+
+	vector<int> frontier;
+	vector<int> active;
+	vector<int> settled;
+	while(!buckets.empty()) {
+		int bucket = buckets.begin()->first;
+		frontier.swap(buckets.begin()->second);
+		buckets.erase(buckets.begin());
+		settled.clear();
+
+		// edges no heavier than delta can lead back into this bucket, so 
+		// they are relaxed until the bucket stays empty
+		while(!frontier.empty()) {
+			active.clear();
+			for(size_t i = 0; i < frontier.size(); i++) {
+				int vertex = frontier[i];
+				int dist = tentative[vertex].load(memory_order_relaxed);
+				if(dist / delta == bucket && dist < relaxedAt[vertex]) {
+					if(relaxedAt[vertex] == INFINITY) {
+						settled.push_back(vertex);
+					}
+					relaxedAt[vertex] = dist;
+					active.push_back(vertex);
+				}
+			}
+			frontier.clear();
+			relaxEdges(active, true);
+			fileReached(bucket, frontier);
+		}
+
+		// heavier edges always lead past this bucket
+		relaxEdges(settled, false);
+		fileReached(bucket, frontier);
+	}
+
+	for(int i = 0; i < m_size; i++) {
+		row[i] = tentative[i].load(memory_order_relaxed);
+	}
+	GRAPH_STATS_LAP(m_searchSeconds);
+	setSettledPreds(source, zeroWeight, pool);
+	GRAPH_STATS_LAP(m_pathSeconds);
+}
+
+
+// setSettledPreds: findShortestPathDelta helper
+// sets the predecessors in source's row of m_table from its final 
+// distances, choosing for each vertex the same one visitVertex() would: 
+// the first vertex settled, in (distance, index value) order, with an edge
+// lying on a shortest path to it. Without edges of weight 0 every vertex 
+// picks among its incoming edges in m_reverseCsr on its own, in parallel.
+// Otherwise the order vertices are settled in depends on the search, so it
+// is replayed with a MinHeap over the edges lying on shortest paths.
+// preconditions:	source's distances are final; zeroWeight is true if any
+//					edge has weight 0
+// postconditions:	every reached vertex in source's row has its predecessor
+//					set
+//
+void Graph::setSettledPreds(int source, bool zeroWeight, ThreadPool &pool) const {
+	const int *row = distRow(source);
+	setPred(source, source, source);
+
+	if(!zeroWeight) {
+		// every edge on a shortest path leads to a longer distance, so the 
+		// vertices at each distance are all settled once the shorter ones
+		// are, in index value order
+		shared_ptr<const CsrGraph> reverse = getReverseCsr();
+		const int *offsets = reverse->getOffsets();
+		const int *adjVertices = reverse->getAdjVertices();
+		const int *weights = reverse->getWeights();
+		pool.parallelFor((m_size + DELTA_CHUNK - 1) / DELTA_CHUNK, [&](int chunk, int) {
+			int end = min(m_size, (chunk + 1) * DELTA_CHUNK);
+			for(int to = chunk * DELTA_CHUNK; to < end; to++) {
+				if(to == source || row[to] == INFINITY) {
+					continue;
+				}
+				int best = -1;
+				for(int i = offsets[to]; i < offsets[to + 1]; i++) {
+					int from = adjVertices[i];
+					if(row[from] != INFINITY && 
+						Traits::add(row[from], weights[i]) == row[to] &&
+						(best == -1 || row[from] < row[best] || 
+						(row[from] == row[best] && from < best))) {
+						best = from;
+					}
+				}
+				setPred(source, to, best);
+			}
+		});
+		return;
+	}
+
+	// replay the order findShortestPathQueue settles vertices in, following
+	// only edges on shortest paths; the first to reach a vertex is its 
+	// predecessor
+	const int *offsets = m_csr->getOffsets();
+	const int *adjVertices = m_csr->getAdjVertices();
+	const int *weights = m_csr->getWeights();
+	vector<char> found(m_size, 0);
+	MinHeap heap;
+	found[source] = 1;
+	heap.push(make_pair(0, source));
+	while(!heap.empty()) {
+		int from = heap.top().second;
+		heap.pop();
+		for(int i = offsets[from]; i < offsets[from + 1]; i++) {
+			int to = adjVertices[i];
+			if(!found[to] && Traits::add(row[from], weights[i]) == row[to]) {
+				found[to] = 1;
+				setPred(source, to, from);
+				heap.push(make_pair(row[to], to));
+			}
+		}
+	}
+}
+
+
+// usesFloydWarshall: findShortestPath helper
+// returns true if findShortestPath() should fill m_table with 
+// findShortestPathFloyd() for the current engine, edges and row limit
+// preconditions:	m_csr is current
+// postconditions:	returns true for FLOYD_WARSHALL, or for AUTOMATIC on
+//					a dense graph, when every row fits in m_table and no
+//					simple path can be as long as FLOYD_INFINITY
+//
+bool Graph::usesFloydWarshall() const {
+	if(m_size == 0 || rowCapacity() < m_size) {
+		return(false);
+	}
+
+	// a path that long would be taken for no path
+	if(static_cast<long long>(m_csr->getMaxWeight()) * (m_size - 1) >= 
+		FLOYD_INFINITY) {
+		return(false);
+	}
+	if(m_engine == FLOYD_WARSHALL) {
+		return(true);
+	}
+	return(m_engine == AUTOMATIC && static_cast<long long>(m_csr->getEdgeCount()) *
+		AUTOMATIC_DENSITY >= static_cast<long long>(m_size) * m_size);
+}
+
+
+// findShortestPathFloyd: findShortestPath helper
+// sets every row of m_table with a blocked Floyd-Warshall. The distances
+// are split into FLOYD_BLOCK x FLOYD_BLOCK blocks; for each diagonal 
+// block, the block itself is updated first, then its row and column of
+// blocks, then all remaining blocks, each step handing blocks to 
+// m_threadCount threads. Predecessors are updated along with distances, 
+// except that if the graph has an edge of weight 0 they are set afterwards
+// row by row with setTightPreds(), since ties along such edges could 
+// otherwise leave a predecessor chain that loops without reaching source.
+// preconditions:	m_csr is current; rowCapacity() = m_size; shortest 
+//					path lengths are less than FLOYD_INFINITY
+// postconditions:	every row of m_table is set and current
+//
+void Graph::findShortestPathFloyd() {
+	// give source i slot i, so that the distances of m_table are one 
+	// m_size x m_size matrix
+	GRAPH_STATS_START();
+	resetTable();
+	for(int i = 0; i < m_size; i++) {
+		assignSlot(i);
+	}
+	size_t cells = static_cast<size_t>(m_size) * m_size;
+	int *dist = m_table.m_dist.data();
+	vector<int> smallPredWork;
+	if(m_size <= SMALL_PRED_LIMIT) {
+		smallPredWork.resize(cells);
+	}
+	int *pred = (m_size <= SMALL_PRED_LIMIT) ? smallPredWork.data() : 
+		m_table.m_pred.data();
+
+	fill(dist, dist + cells, static_cast<int>(FLOYD_INFINITY));
+	const int *offsets = m_csr->getOffsets();
+	const int *adjVertices = m_csr->getAdjVertices();
+	const int *weights = m_csr->getWeights();
+	bool zeroWeight = false;
+	for(int u = 0; u < m_size; u++) {
+		size_t row = static_cast<size_t>(u) * m_size;
+		dist[row + u] = 0;
+		pred[row + u] = u;
+		for(int i = offsets[u]; i < offsets[u + 1]; i++) {
+			zeroWeight = zeroWeight || weights[i] == 0;
+			if(weights[i] < dist[row + adjVertices[i]]) {
+				dist[row + adjVertices[i]] = weights[i];
+				pred[row + adjVertices[i]] = u;
+			}
+		}
+	}
+
+	GRAPH_STATS_LAP(m_resetSeconds);
+
+	// blocks in the same step never write what another of them reads, so
+	// each step can be shared between threads
+	int blocks = (m_size + FLOYD_BLOCK - 1) / FLOYD_BLOCK;
+	ThreadPool &pool = getPool();
+	for(int pivot = 0; pivot < blocks; pivot++) {
+		int k = pivot * FLOYD_BLOCK;
+		updateBlock(dist, pred, k, k, k);
+		pool.parallelFor(2 * (blocks - 1), [&](int index, int) {
+			int other = index / 2;
+			other = (other < pivot ? other : other + 1) * FLOYD_BLOCK;
+			if(index % 2 == 0) {
+				updateBlock(dist, pred, k, other, k);
+			} else {
+				updateBlock(dist, pred, other, k, k);
+			}
+		});
+		pool.parallelFor((blocks - 1) * (blocks - 1), [&](int index, int) {
+			int rowBlock = index / (blocks - 1);
+			int columnBlock = index % (blocks - 1);
+			rowBlock = (rowBlock < pivot ? rowBlock : rowBlock + 1) * FLOYD_BLOCK;
+			columnBlock = (columnBlock < pivot ? columnBlock : columnBlock + 1) * FLOYD_BLOCK;
+			updateBlock(dist, pred, rowBlock, columnBlock, k);
+		});
+	}
+
+	GRAPH_STATS_LAP(m_searchSeconds);
+
+	if(zeroWeight) {
+		// every source writes only to its own row of m_table
+		vector<int> queues(static_cast<size_t>(pool.getThreadCount()) * m_size);
+		pool.parallelFor(m_size, [this, &queues](int source, int thread) {
+			setTightPreds(source, queues.data() + static_cast<size_t>(thread) * m_size);
+		});
+		GRAPH_STATS_LAP(m_pathSeconds);
+	} else {
+		for(size_t i = 0; i < cells; i++) {
+			if(dist[i] >= FLOYD_INFINITY) {
+				dist[i] = INFINITY;
+			}
+		}
+		if(m_size <= SMALL_PRED_LIMIT) {
+			copy(pred, pred + cells, m_table.m_smallPred.begin());
+		}
+		GRAPH_STATS_LAP(m_searchSeconds);
+	}
+	for(int i = 0; i < m_size; i++) {
+		m_slotVersion[i] = m_version;
+	}
+	GRAPH_STATS_COUNT(m_rows, m_size);
+	GRAPH_STATS_RECORD();
+}
+
+
+// updateBlock: findShortestPathFloyd helper
+// relaxes the block of rows starting at rowBlock and columns starting at
+// columnBlock through every vertex of the block starting at pivotBlock
+// preconditions:	dist and pred are m_size x m_size matrices; the block
+//					starts are multiples of FLOYD_BLOCK
+// postconditions:	dist[i][j] = min(dist[i][j], dist[i][k] + dist[k][j])
+//					over the block, with pred updated to match
+//
+void Graph::updateBlock(int *dist, int *pred, int rowBlock, int columnBlock,
+	int pivotBlock) const {
+	int rowEnd = min(rowBlock + FLOYD_BLOCK, m_size);
+	int columnCount = min(columnBlock + FLOYD_BLOCK, m_size) - columnBlock;
+	int pivotEnd = min(pivotBlock + FLOYD_BLOCK, m_size);
+	for(int k = pivotBlock; k < pivotEnd; k++) {
+		size_t rowK = static_cast<size_t>(k) * m_size + columnBlock;
+		for(int i = rowBlock; i < rowEnd; i++) {
+			size_t rowI = static_cast<size_t>(i) * m_size;
+			if(dist[rowI + k] < FLOYD_INFINITY) {
+				minPlusRow(dist[rowI + k], dist + rowK, pred + rowK, 
+					dist + rowI + columnBlock, pred + rowI + columnBlock, columnCount);
+			}
+		}
+	}
+}
+
+
+// minPlusRow: updateBlock helper
+// for j < count, sets distI[j] to distIK + distK[j] and predI[j] to 
+// predK[j] wherever that is shorter. Uses AVX2 when compiled for it and
+// a loop the compiler can vectorize otherwise.
+// preconditions:	each array holds count entries; distIK < FLOYD_INFINITY
+//					and distK[j] <= FLOYD_INFINITY
+// postconditions:	distI[j] = min(distI[j], distIK + distK[j])
+//
+void Graph::minPlusRow(int distIK, const int *distK, const int *predK,
+	int *distI, int *predI, int count) {
+	int j = 0;
+#if defined(__AVX2__)
+	__m256i through = _mm256_set1_epi32(distIK);
+	for(; j + 8 <= count; j += 8) {
+		__m256i candidate = _mm256_add_epi32(through, 
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(distK + j)));
+		__m256i current = _mm256_loadu_si256(reinterpret_cast<__m256i*>(distI + j));
+		__m256i shorter = _mm256_cmpgt_epi32(current, candidate);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(distI + j), 
+			_mm256_min_epi32(current, candidate));
+		__m256i predCurrent = _mm256_loadu_si256(reinterpret_cast<__m256i*>(predI + j));
+		__m256i predThrough = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(predK + j));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(predI + j),
+			_mm256_blendv_epi8(predCurrent, predThrough, shorter));
+	}
+#endif
+	// written without branches so that it vectorizes
+	for(; j < count; j++) {
+		int candidate = distIK + distK[j];
+		bool shorter = candidate < distI[j];
+		distI[j] = shorter ? candidate : distI[j];
+		predI[j] = shorter ? predK[j] : predI[j];
+	}
+}
+
+
+// setTightPreds: findShortestPathFloyd helper
+// sets the predecessors in source's row of m_table from its distances
+// with a breadth-first search from source that follows only edges lying
+// on a shortest path, so that every predecessor chain leads back to 
+// source even across edges of weight 0
+// preconditions:	source has a slot whose distances are final, with 
+//					FLOYD_INFINITY standing for no path; queue holds 
+//					m_size entries
+// postconditions:	source's row of m_table is set, with INFINITY 
+//					standing for no path
+//
+void Graph::setTightPreds(int source, int *queue) const {
+	int *row = distRow(source);
+	const int *offsets = m_csr->getOffsets();
+	const int *adjVertices = m_csr->getAdjVertices();
+	const int *weights = m_csr->getWeights();
+
+	// a vertex is marked as found by setting its distance to -1 - distance
+	// until the search ends
+	int head = 0;
+	int tail = 0;
+	queue[tail++] = source;
+	setPred(source, source, source);
+	row[source] = -1;
+	while(head < tail) {
+		int from = queue[head++];
+		int dist = -1 - row[from];
+		for(int i = offsets[from]; i < offsets[from + 1]; i++) {
+			int to = adjVertices[i];
+			if(row[to] >= 0 && row[to] < FLOYD_INFINITY && 
+				Traits::add(dist, weights[i]) == row[to]) {
+				setPred(source, to, from);
+				row[to] = -1 - row[to];
+				queue[tail++] = to;
+			}
+		}
+	}
+	for(int i = 0; i < m_size; i++) {
+		row[i] = (row[i] < 0) ? -1 - row[i] : static_cast<int>(INFINITY);
+	}
+}
+
+
+// setEngine
+// selects the algorithm used by findShortestPath()
+// preconditions:	none
+// postconditions:	m_engine = engine
+//
+void Graph::setEngine(Engine engine) {
+	m_engine = engine;
+}
+
+
+// getEngine
+// returns the algorithm used by findShortestPath()
+// preconditions:	none
+// postconditions:	returns m_engine
+//
+Graph::Engine Graph::getEngine() const {
+	return(m_engine);
+}
+
+
+// setThreadCount
+// sets the number of threads findShortestPath() uses to fill m_table. A
+// threadCount less than 1 uses one thread per hardware core. The table
+// produced is the same for every thread count. The threads are started
+// the first time they are needed and kept until the count changes.
+// preconditions:	none
+// postconditions:	m_threadCount = threadCount, or the number of hardware
+//					cores if threadCount < 1; m_pool is stopped if the 
+//					count changed
+//
+void Graph::setThreadCount(int threadCount) {
+	if(threadCount < 1) {
+		threadCount = static_cast<int>(thread::hardware_concurrency());
+	}
+	threadCount = threadCount < 1 ? 1 : threadCount;
+	if(threadCount != m_threadCount) {
+		m_pool.reset();
+	}
+	m_threadCount = threadCount;
+}
+
+
+// getThreadCount
+// returns the number of threads findShortestPath() uses to fill m_table
+// preconditions:	none
+// postconditions:	returns m_threadCount
+//
+int Graph::getThreadCount() const {
+	return(m_threadCount);
+}
+
+
+// setDeltaWidth
+// sets the bucket width the DELTA_STEPPING engine groups tentative 
+// distances by. Narrow buckets waste less work on distances that later
+// improve; wide buckets give each parallel step more vertices. A 
+// deltaWidth less than 1 picks the width from the edges each search: 
+// the largest weight divided by the average number of edges per vertex.
+// preconditions:	none
+// postconditions:	m_deltaWidth = deltaWidth, or 0 if deltaWidth < 1
+//
+void Graph::setDeltaWidth(int deltaWidth) {
+	m_deltaWidth = deltaWidth < 1 ? 0 : deltaWidth;
+}
+
+
+// getDeltaWidth
+// returns the bucket width of the DELTA_STEPPING engine, or 0 if it is
+// picked from the edges
+// preconditions:	none
+// postconditions:	returns m_deltaWidth
+//
+int Graph::getDeltaWidth() const {
+	return(m_deltaWidth);
+}
+
+
+// getSearchStats
+// returns the work done computing rows of m_table since the last call to
+// resetSearchStats(), or all zeros if GRAPH_STATS was not defined
+// preconditions:	no rows are being computed
+// postconditions:	returns m_stats
+//
+Graph::SearchStats Graph::getSearchStats() const {
+	lock_guard<mutex> lock(m_statsMutex);
+	return(m_stats);
+}
+
+
+// resetSearchStats
+// sets every field of the SearchStats to 0
+// preconditions:	no rows are being computed
+// postconditions:	m_stats is all zeros
+//
+void Graph::resetSearchStats() {
+	lock_guard<mutex> lock(m_statsMutex);
+	m_stats = SearchStats();
+}
+
+
+// setIncrementalRepair
+// turns incremental repair of m_table on or off. While it is on, 
+// insertEdge(int, int, int) and removeEdge(int, int) update only the 
+// entries of current rows that the edge change affects, leaving them with
+// the same distances a call to findShortestPath() would produce. While it
+// is off, rows the change affects are recomputed the next time they are
+// needed.
+// preconditions:	none
+// postconditions:	m_incrementalRepair = enabled
+//
+void Graph::setIncrementalRepair(bool enabled) {
+	m_incrementalRepair = enabled;
+}
+
+
+// getIncrementalRepair
+// returns true if incremental repair of m_table is on, else false
+// preconditions:	none
+// postconditions:	returns m_incrementalRepair
+//
+bool Graph::getIncrementalRepair() const {
+	return(m_incrementalRepair);
+}
+
+
+// setRowLimit
+// sets the most rows m_table keeps at once. When a row is needed and the
+// limit is reached, the least recently used row is evicted. A rowLimit 
+// less than 1 removes the limit, so m_table can hold every row.
+// preconditions:	none
+// postconditions:	m_rowLimit = rowLimit, or 0 if rowLimit < 1; rows past 
+//					the limit are evicted, least recently used first
+//
+void Graph::setRowLimit(int rowLimit) {
+	m_rowLimit = rowLimit < 1 ? 0 : rowLimit;
+	if(static_cast<int>(m_slotSource.size()) <= rowCapacity()) {
+		return;
+	}
+
+	while(static_cast<int>(m_recentRows.size()) > rowCapacity()) {
+		evictRow();
+	}
+
+	// move the surviving rows into the first slots and release the rest
+	Table table;
+	vector<int> slotSource;
+	vector<unsigned long> slotVersion;
+	for(size_t slot = 0; slot < m_slotSource.size(); slot++) {
+		int source = m_slotSource[slot];
+		if(source != -1) {
+			m_rowSlot[source] = static_cast<int>(slotSource.size());
+			slotSource.push_back(source);
+			slotVersion.push_back(m_slotVersion[slot]);
+			size_t first = slot * m_size, last = (slot + 1) * m_size;
+			table.m_dist.insert(table.m_dist.end(), m_table.m_dist.begin() + first,
+				m_table.m_dist.begin() + last);
+			if(m_size <= SMALL_PRED_LIMIT) {
+				table.m_smallPred.insert(table.m_smallPred.end(), 
+					m_table.m_smallPred.begin() + first, 
+					m_table.m_smallPred.begin() + last);
+			} else {
+				table.m_pred.insert(table.m_pred.end(), 
+					m_table.m_pred.begin() + first, m_table.m_pred.begin() + last);
+			}
+		}
+	}
+	std::swap(m_table, table);
+	m_slotSource.swap(slotSource);
+	m_slotVersion.swap(slotVersion);
+}
+
+
+// getRowLimit
+// returns the most rows m_table keeps at once, or 0 if there is no limit
+// preconditions:	none
+// postconditions:	returns m_rowLimit
+//
+int Graph::getRowLimit() const {
+	return(m_rowLimit);
+}
+
+
+// getVersion
+// returns the graph version, which changes whenever the edges change
+// preconditions:	none
+// postconditions:	returns m_version
+//
+unsigned long Graph::getVersion() const {
+	return(m_version);
+}
+
+
+// getCsr
+// returns a read-only compressed sparse row view of the current edges.
+// The view is built from m_vertices the first time it is requested after
+// a change to the edges and is shared until the edges change again.
+// preconditions:	none
+// postconditions:	returns m_csr, built from m_vertices if it was stale
+//
+shared_ptr<const CsrGraph> Graph::getCsr() const {
+	if(m_csr == nullptr) {
+		m_csr = buildCsr();
+	}
+	return(m_csr);
+}
+
+
+// getReverseCsr
+// returns the transpose of getCsr(), listing each vertex's incoming edges.
+// Built on demand and shared until the edges change, like getCsr().
+// preconditions:	none
+// postconditions:	returns m_reverseCsr, built from getCsr() if it was stale
+//
+shared_ptr<const CsrGraph> Graph::getReverseCsr() const {
+	if(m_reverseCsr == nullptr) {
+		m_reverseCsr = make_shared<const CsrGraph>(getCsr()->reversed());
+	}
+	return(m_reverseCsr);
+}
+
+
+// buildCsr
+// packs the Edge linked lists in m_vertices into a new CsrGraph
+// preconditions:	none
+// postconditions:	returns a CsrGraph holding every edge in m_vertices
+//
+shared_ptr<const CsrGraph> Graph::buildCsr() const {
+	vector<int> offsets(m_size + 1, 0);
+	for(int i = 0; i < m_size; i++) {
+		offsets[i + 1] = offsets[i];
+		for(Edge *edge = m_vertices[i].m_edgeHead; edge != nullptr; edge = edge->m_nextEdge) {
+			offsets[i + 1]++;
+		}
+	}
+
+	vector<int> adjVertices(offsets[m_size]);
+	vector<int> weights(offsets[m_size]);
+	for(int i = 0; i < m_size; i++) {
+		int pos = offsets[i];
+		for(Edge *edge = m_vertices[i].m_edgeHead; edge != nullptr; edge = edge->m_nextEdge) {
+			adjVertices[pos] = edge->m_adjVertex;
+			weights[pos] = edge->m_weight;
+			pos++;
+		}
+	}
+	return(make_shared<const CsrGraph>(m_size, std::move(offsets),
+		std::move(adjVertices), std::move(weights)));
+}
+
+
+// getPool
+// returns the ThreadPool of m_threadCount threads that findShortestPath(),
+// updateTable(...) and the row searches share, starting it the first time
+// it is needed, the way getCsr() builds m_csr
+// preconditions:	not called while a loop is running on m_pool
+// postconditions:	returns *m_pool, started if it was nullptr
+//
+ThreadPool &Graph::getPool() const {
+	if(m_pool == nullptr) {
+		m_pool.reset(new ThreadPool(m_threadCount));
+	}
+	return(*m_pool);
+}
+
+
+// findLowestMove
+// finds the unvisited vertex with the lowest distance in source's row
+// preconditions:	source must be the index value of the desired source
+//					vertex. visited holds m_size entries.
+// postconditions:	returns the index value of that vertex, or INFINITY if
+//					every reachable vertex has been visited
+//
+int Graph::findLowestMove(int source, const char *visited) const {
+	const int *row = distRow(source);
+	int indexOfLowest = INFINITY;
+	int lowestWeight = INFINITY;
+	for(int i = 0; i < m_size; i++) {
+		if(!visited[i] && row[i] < lowestWeight) {
+			lowestWeight = row[i];
+			indexOfLowest = i;
+		}
+	}
+	return(indexOfLowest);
+}
+
+
+// setSource
+// sets the source vertex's distance and predecessor in m_table
+// preconditions:	source must be the index value of the desired source vertex
+// postconditions:	source's distance is 0 and it is its own predecessor
+//
+void Graph::setSource(int source) const {
+	distRow(source)[source] = 0;
+	setPred(source, source, source);
+}
+
+
+// visitVertex
+// sets any new shortest paths in source's row of m_table through the 
+// edges leaving dest. If queue is not nullptr, every vertex whose distance
+// improves is pushed onto queue.
+// preconditions:	source and dest must be the index value of the desired 
+//					vertices. dest's distance is final.
+// postconditions:	any new shortest paths set in m_table and pushed onto
+//					queue
+//
+template <typename Queue>
+void Graph::visitVertex(int source, int dest, Queue *queue) const {
+	int *row = distRow(source);
+	const int *offsets = m_csr->getOffsets();
+	const int *adjVertices = m_csr->getAdjVertices();
+	const int *weights = m_csr->getWeights();
+	int destDist = row[dest];
+	GRAPH_STATS_COUNT(m_settled, 1);
+	GRAPH_STATS_COUNT(m_edgesScanned, offsets[dest + 1] - offsets[dest]);
+
+	// weights are not negative, so a vertex whose distance is final never
+	// improves and needs no visited check
+	for(int i = offsets[dest]; i < offsets[dest + 1]; i++) {
+		int adj = adjVertices[i];
+		int adjDist = Traits::add(destDist, weights[i]);
+		if(adjDist < row[adj]) {
+			row[adj] = adjDist;
+			setPred(source, adj, dest);
+			GRAPH_STATS_COUNT(m_relaxations, 1);
+			if(queue != nullptr) {
+				queue->push(make_pair(row[adj], adj));
+				GRAPH_STATS_COUNT(m_pushes, 1);
+			}
+		}
+	}
+}
+
+
+// resetTable
+// removes every row from m_table
+// preconditions:	none
+// postconditions:	m_table is empty and no source has a slot
+//
+void Graph::resetTable() const {
+	m_table.m_dist.clear();
+	m_table.m_smallPred.clear();
+	m_table.m_pred.clear();
+	m_slotSource.clear();
+	m_slotVersion.clear();
+	m_recentRows.clear();
+	m_rowSlot.assign(m_size, -1);
+	m_recentPosition.assign(m_size, m_recentRows.end());
+}
+
+
+// resetRow
+// sets every distance in source's row of m_table to INFINITY
+// preconditions:	source must be the index value of a vertex with a slot
+// postconditions:	every vertex in source's row has no path
+//
+void Graph::resetRow(int source) const {
+	int *row = distRow(source);
+	fill(row, row + m_size, static_cast<int>(INFINITY));
+}
+
+
+// distRow
+// returns the distances in source's row of m_table
+// preconditions:	source must be the index value of a vertex with a slot
+// postconditions:	returns a pointer to the m_size distances of the row
+//
+int *Graph::distRow(int source) const {
+	return(&m_table.m_dist[static_cast<size_t>(m_rowSlot[source]) * m_size]);
+}
+
+
+// getPred
+// returns the predecessor of dest on the shortest path from source
+// preconditions:	source and dest must be index values. source must have
+//					a slot and a path to dest.
+// postconditions:	returns the predecessor's index value, or source if
+//					dest = source
+//
+int Graph::getPred(int source, int dest) const {
+	size_t index = static_cast<size_t>(m_rowSlot[source]) * m_size + dest;
+	if(m_size <= SMALL_PRED_LIMIT) {
+		return(m_table.m_smallPred[index]);
+	}
+	return(m_table.m_pred[index]);
+}
+
+
+// setPred
+// sets the predecessor of dest on the shortest path from source
+// preconditions:	source, dest and pred must be index values. source must
+//					have a slot.
+// postconditions:	getPred(source, dest) = pred
+//
+void Graph::setPred(int source, int dest, int pred) const {
+	size_t index = static_cast<size_t>(m_rowSlot[source]) * m_size + dest;
+	if(m_size <= SMALL_PRED_LIMIT) {
+		m_table.m_smallPred[index] = static_cast<uint16_t>(pred);
+	} else {
+		m_table.m_pred[index] = pred;
 	}
 }
 
 
 // displayAll
-// displays all shortest paths for all vertices in m_vertices
+// displays all shortest paths for all vertices in m_vertices, computing 
+// any row of m_table that is missing or out of date
 // preconditions:	none
 // postconditions:	all shortest paths for all vertices in m_vertices are
 //					displayed to the console
@@ -424,17 +2416,19 @@ void Graph::resetTable() {
 void Graph::displayAll() const {
 	if(m_size > 0) {
 		displayHeader();
+		vector<int> path(m_size);	// no path has more than m_size vertices
 		for(int i = 0; i < m_size; i++) {
+			const int *row = getRow(i);
 			cout << *m_vertices[i].m_data << endl;
 			for(int j = 0; j < m_size; j++) {
-				if(m_table[i][j].m_path != 0 && m_table[i][j].m_path != INFINITY) {
+				if(j != i && row[j] != INFINITY) {
 					cout.width(27); cout << "";
 					cout.width(7); cout << std::left << i + 1;
 					cout.width(7); cout << std::left << j + 1;
-					cout.width(11); cout << std::left << m_table[i][j].m_dist;
-					displayPath(i, j);
+					cout.width(11); cout << std::left << row[j];
+					displayPath(path.data(), getPath(i + 1, j + 1, path.data(), m_size));
 					cout << endl;
-				} else if(m_table[i][j].m_path == INFINITY) {
+				} else if(row[j] == INFINITY) {
 					cout.width(27); cout << "";
 					cout.width(7); cout << std::left << i + 1;
 					cout.width(7); cout << std::left << j + 1;
@@ -468,7 +2462,8 @@ void Graph::displayHeader() const {
 
 
 // display
-// displays the path, including Vertex title's, between source and dest
+// displays the path, including Vertex title's, between source and dest,
+// computing source's row of m_table if it is missing or out of date
 // preconditions:	none
 // postconditions:	the path, including Vertex title's, between source and 
 //					dest is displayed to the console
@@ -484,55 +2479,563 @@ void Graph::display(int source, int dest) const {
 		return;
 	}
 
-	if(!m_table[source - 1][dest - 1].m_visited) {
+	vector<int> path(m_size);
+	int length = getPath(source, dest, path.data(), m_size);
+	if(length == 0) {
 		cout << "no such path" << endl;
 		return;
 	}
 
-	cout << source << '\t' << dest << '\t' << m_table[source - 1][dest - 1].m_dist << '\t';
-	displayPath(source - 1, dest - 1);
+	cout << source << '\t' << dest << '\t' << distRow(source - 1)[dest - 1] << '\t';
+	displayPath(path.data(), length);
 	cout << endl;
-	displayLocations(source - 1, dest - 1);
+	for(int i = 0; i < length; i++) {
+		cout << *m_vertices[path[i] - 1].m_data << endl;
+	}
 }
 
 
-// displayPath
-// displays the shortest path from source to dest.
-// preconditions:	source must be the index value of the desired source vertex
-// postconditions:	shortest path from source to dest sent to console
+// query
+// finds the shortest path from source to dest without using m_table, 
+// using the search selected by mode. The search stops as soon as dest's
+// distance is known to be final. Scratch state is kept per thread, so 
+// concurrent queries on a Graph whose edges are not being changed are 
+// safe once getCsr() and, for BIDIRECTIONAL, getReverseCsr() have been 
+// called.
+// preconditions:	source and dest must be the numerical-order value of the
+//					vertices they represent (not the index value)
+// postconditions:	returns the shortest path from source to dest, or a 
+//					PathResult with m_found = false if there is none
 //
-void Graph::displayPath(int source, int dest) const {
-	displayPathHelper(source, dest);
-	cout << dest + 1;
+Graph::PathResult Graph::query(int source, int dest, QueryMode mode) const {
+	PathResult result;
+	if(source < 1 || source > m_size || dest < 1 || dest > m_size) {
+		return(result);
+	}
+
+	if(mode == BIDIRECTIONAL) {
+		queryBidirectional(source - 1, dest - 1, result);
+	} else {
+		queryDijkstra(source - 1, dest - 1, result);
+	}
+	return(result);
 }
 
 
-// displayPathHelper
-// displays the shortest path from source to dest.
-// preconditions:	source must be the index value of the desired source vertex
-// postconditions:	shortest path from source to dest sent to console
+// lookup
+// returns the shortest path from source to dest stored in source's row of
+// m_table, computing the row first if it is missing or out of date. Later
+// lookups from the same source are answered from the row without a search.
+// preconditions:	source and dest must be the numerical-order value of the
+//					vertices they represent (not the index value)
+// postconditions:	returns the shortest path from source to dest, or a 
+//					PathResult with m_found = false if there is none
 //
-void Graph::displayPathHelper(int source, int dest) const {
-	if(m_table[source][dest].m_path > 0) {
-		displayPathHelper(source, m_table[source][dest].m_path - 1);
-		cout << m_table[source][dest].m_path << " ";
-	} 
+Graph::PathResult Graph::lookup(int source, int dest) const {
+	PathResult result;
+	if(source < 1 || source > m_size || dest < 1 || dest > m_size) {
+		return(result);
+	}
+
+	const int *row = getRow(source - 1);
+	if(row[dest - 1] == INFINITY) {
+		return(result);
+	}
+	result.m_found = true;
+	result.m_dist = row[dest - 1];
+	int vertex = dest - 1;
+	result.m_path.push_back(vertex + 1);
+	while(vertex != source - 1) {
+		vertex = getPred(source - 1, vertex);
+		result.m_path.push_back(vertex + 1);
+	}
+	reverse(result.m_path.begin(), result.m_path.end());
+	return(result);
 }
 
 
-// displayLocations
-// displays the data of vertices visited in the shortest path between source
-// and dest
-// preconditions:	source must be the index value of the desired source vertex
-// postconditions:	locations visited in shortest path between source and dest sent
-//					to console
-//
-void Graph::displayLocations(int source, int dest) const {
-	if(m_table[source][dest].m_path > 0) {
-		displayLocations(source, m_table[source][dest].m_path - 1);
-		cout << *m_vertices[dest].m_data << endl;
-	} else if(m_table[source][dest].m_path == 0) {
-		cout << *m_vertices[dest].m_data << endl;
+// getPath
+// writes the vertices of the shortest path from source to dest, by 
+// numerical-order value from source to dest, into buffer, computing 
+// source's row of m_table if it is missing or out of date. The path is 
+// walked backward from dest with a loop, so long paths need no stack, and 
+// nothing is allocated. If the path has more than capacity vertices, 
+// buffer is left unchanged; calling again with a buffer of the returned 
+// size gets the path.
+// preconditions:	source and dest must be the numerical-order value of the
+//					vertices they represent (not the index value); buffer 
+//					holds at least capacity entries
+// postconditions:	returns the number of vertices in the path, or 0 if 
+//					there is none; if it is no more than capacity, buffer
+//					holds the path
+//
+int Graph::getPath(int source, int dest, int *buffer, int capacity) const {
+	if(source < 1 || source > m_size || dest < 1 || dest > m_size) {
+		return(0);
+	}
+
+	int length = pathLength(source - 1, dest - 1);
+	if(length <= capacity) {
+		int vertex = dest - 1;
+		for(int i = length - 1; i >= 0; i--) {
+			buffer[i] = vertex + 1;
+			if(i > 0) {
+				vertex = getPred(source - 1, vertex);
+			}
+		}
+	}
+	return(length);
+}
+
+
+// getPathLocations
+// writes the data, holding the title, of each vertex on the shortest path 
+// from source to dest into buffer, the same way getPath(...) writes the 
+// vertices. The pointers stay valid until the Graph is rebuilt or destroyed.
+// preconditions:	source and dest must be the numerical-order value of the
+//					vertices they represent (not the index value); buffer 
+//					holds at least capacity entries
+// postconditions:	returns the number of vertices in the path, or 0 if 
+//					there is none; if it is no more than capacity, buffer
+//					holds the path's data
+//
+int Graph::getPathLocations(int source, int dest, const GraphData **buffer, 
+	int capacity) const {
+	if(source < 1 || source > m_size || dest < 1 || dest > m_size) {
+		return(0);
+	}
+
+	int length = pathLength(source - 1, dest - 1);
+	if(length <= capacity) {
+		int vertex = dest - 1;
+		for(int i = length - 1; i >= 0; i--) {
+			buffer[i] = m_vertices[vertex].m_data;
+			if(i > 0) {
+				vertex = getPred(source - 1, vertex);
+			}
+		}
+	}
+	return(length);
+}
+
+
+// queryBatch
+// finds the shortest path for every (source, dest) pair in pairs. Pairs 
+// are grouped by source, and each group is answered from source's row of
+// m_table if it is current, or else by one search from source that stops
+// once every dest of the group is settled. Groups are handed out to 
+// m_threadCount threads. Concurrent calls are safe under the same 
+// conditions as query(), as long as no other call is filling m_table.
+// preconditions:	the pairs hold numerical-order values (not index values)
+// postconditions:	returns the answers in pairs' order; a pair with an 
+//					invalid vertex has no path
+//
+Graph::BatchResult Graph::queryBatch(const vector<pair<int, int> > &pairs) const {
+	BatchResult result;
+	int pairCount = static_cast<int>(pairs.size());
+	result.m_dist.assign(pairCount, INFINITY);
+	result.m_pathStart.assign(pairCount + 1, 0);
+
+	// sort the valid pairs by source, then dest, and find where each 
+	// source's group starts
+	vector<int> order;
+	for(int i = 0; i < pairCount; i++) {
+		if(pairs[i].first >= 1 && pairs[i].first <= m_size && 
+			pairs[i].second >= 1 && pairs[i].second <= m_size) {
+			order.push_back(i);
+		}
+	}
+	stable_sort(order.begin(), order.end(), [&pairs](int a, int b) {
+		return(pairs[a] < pairs[b]);
+	});
+	vector<int> groupStart;
+	for(size_t i = 0; i < order.size(); i++) {
+		if(i == 0 || pairs[order[i]].first != pairs[order[i - 1]].first) {
+			groupStart.push_back(static_cast<int>(i));
+		}
+	}
+	int groupCount = static_cast<int>(groupStart.size());
+	groupStart.push_back(static_cast<int>(order.size()));
+	if(groupCount == 0) {
+		return(result);
+	}
+
+	// every group writes only its own pairs' entries and its own paths
+	getCsr();
+	vector<int> pathLength(pairCount, 0);
+	vector<vector<int> > groupPaths(groupCount);
+	vector<char> searched(groupCount, 0);
+	ThreadPool pool(m_threadCount < groupCount ? m_threadCount : groupCount);
+	pool.parallelFor(groupCount, [&](int group, int) {
+		searched[group] = answerGroup(pairs, order.data() + groupStart[group],
+			groupStart[group + 1] - groupStart[group], result, pathLength, 
+			groupPaths[group]);
+	});
+
+	for(int i = 0; i < pairCount; i++) {
+		result.m_pathStart[i + 1] = result.m_pathStart[i] + pathLength[i];
+	}
+	result.m_vertices.resize(result.m_pathStart[pairCount]);
+	pool.parallelFor(groupCount, [&](int group, int) {
+		const int *path = groupPaths[group].data();
+		for(int i = groupStart[group]; i < groupStart[group + 1]; i++) {
+			int index = order[i];
+			copy(path, path + pathLength[index], 
+				result.m_vertices.begin() + result.m_pathStart[index]);
+			path += pathLength[index];
+		}
+	});
+	for(int i = 0; i < groupCount; i++) {
+		result.m_searches += searched[i];
+	}
+	return(result);
+}
+
+
+// queryDijkstra: query helper
+// searches forward from source until dest is settled
+// preconditions:	source and dest must be the index values of the desired
+//					vertices
+// postconditions:	result holds the shortest path from source to dest
+//
+void Graph::queryDijkstra(int source, int dest, PathResult &result) const {
+	shared_ptr<const CsrGraph> csr = getCsr();
+	const int *offsets = csr->getOffsets();
+	const int *adjVertices = csr->getAdjVertices();
+	const int *weights = csr->getWeights();
+	Scratch &scratch = threadScratch();
+	scratch.prepare(m_size);
+
+	MinHeap heap;
+	scratch.reach(source, 0, -1);
+	heap.push(make_pair(0, source));
+	while(!heap.empty()) {
+		int dist = heap.top().first;
+		int vertex = heap.top().second;
+		heap.pop();
+		if(scratch.m_visited[vertex] || dist > scratch.m_dist[vertex]) {
+			continue;
+		}
+
+		scratch.m_visited[vertex] = true;
+		result.m_settled++;
+		if(vertex == dest) {
+			break;
+		}
+
+		for(int i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+			int adj = adjVertices[i];
+			int adjDist = Traits::add(dist, weights[i]);
+			if(!scratch.m_visited[adj] && adjDist < scratch.m_dist[adj]) {
+				scratch.reach(adj, adjDist, vertex);
+				heap.push(make_pair(adjDist, adj));
+			}
+		}
+	}
+
+	if(scratch.m_visited[dest]) {
+		extractPath(scratch, dest, result);
+	}
+	scratch.clear();
+}
+
+
+// answerGroup: queryBatch helper
+// answers the count pairs whose indices are order[0] through 
+// order[count - 1], which share one source and are sorted by dest. The 
+// answers come from source's row of m_table if it is current, or else from
+// a search that stops once every dest is settled. Sets result.m_dist and 
+// pathLength for each pair and appends its path, from source to dest, to
+// paths.
+// preconditions:	the pairs hold valid numerical-order values; getCsr() has
+//					been called
+// postconditions:	returns true if a search was run, false if the row of
+//					m_table was used
+//
+bool Graph::answerGroup(const vector<pair<int, int> > &pairs, const int *order,
+	int count, BatchResult &result, vector<int> &pathLength, 
+	vector<int> &paths) const {
+	int source = pairs[order[0]].first - 1;
+	bool search = !isCurrent(source);
+	Scratch &scratch = threadScratch();
+	if(search) {
+		// the distinct dests, in increasing order
+		vector<int> dests;
+		for(int i = 0; i < count; i++) {
+			if(i == 0 || pairs[order[i]].second != pairs[order[i - 1]].second) {
+				dests.push_back(pairs[order[i]].second - 1);
+			}
+		}
+
+		shared_ptr<const CsrGraph> csr = getCsr();
+		const int *offsets = csr->getOffsets();
+		const int *adjVertices = csr->getAdjVertices();
+		const int *weights = csr->getWeights();
+		scratch.prepare(m_size);
+
+		MinHeap heap;
+		int remaining = static_cast<int>(dests.size());
+		scratch.reach(source, 0, -1);
+		heap.push(make_pair(0, source));
+		while(!heap.empty()) {
+			int dist = heap.top().first;
+			int vertex = heap.top().second;
+			heap.pop();
+			if(scratch.m_visited[vertex] || dist > scratch.m_dist[vertex]) {
+				continue;
+			}
+
+			scratch.m_visited[vertex] = true;
+			if(binary_search(dests.begin(), dests.end(), vertex) && 
+				--remaining == 0) {
+				break;
+			}
+
+			for(int i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+				int adj = adjVertices[i];
+				int adjDist = Traits::add(dist, weights[i]);
+				if(!scratch.m_visited[adj] && adjDist < scratch.m_dist[adj]) {
+					scratch.reach(adj, adjDist, vertex);
+					heap.push(make_pair(adjDist, adj));
+				}
+			}
+		}
+	}
+
+	for(int i = 0; i < count; i++) {
+		int dest = pairs[order[i]].second - 1;
+		if(search ? !scratch.m_visited[dest] : distRow(source)[dest] == INFINITY) {
+			continue;
+		}
+		result.m_dist[order[i]] = search ? scratch.m_dist[dest] : 
+			distRow(source)[dest];
+		size_t start = paths.size();
+		for(int vertex = dest; vertex != -1; ) {
+			paths.push_back(vertex + 1);
+			if(search) {
+				vertex = scratch.m_path[vertex];
+			} else {
+				vertex = (vertex == source) ? -1 : getPred(source, vertex);
+			}
+		}
+		reverse(paths.begin() + start, paths.end());
+		pathLength[order[i]] = static_cast<int>(paths.size() - start);
+	}
+	if(search) {
+		scratch.clear();
+	}
+	return(search);
+}
+
+
+// queryBidirectional: query helper
+// searches forward from source and backward from dest until the 
+// frontiers meet on a shortest path
+// preconditions:	source and dest must be the index values of the desired
+//					vertices
+// postconditions:	result holds the shortest path from source to dest
+//
+void Graph::queryBidirectional(int source, int dest, PathResult &result) const {
+	shared_ptr<const CsrGraph> csr = getCsr();
+	shared_ptr<const CsrGraph> reverseCsr = getReverseCsr();
+	Scratch &forward = threadScratch(0);
+	Scratch &backward = threadScratch(1);
+	forward.prepare(m_size);
+	backward.prepare(m_size);
+
+	MinHeap forwardHeap;
+	MinHeap backwardHeap;
+	forward.reach(source, 0, -1);
+	backward.reach(dest, 0, -1);
+	forwardHeap.push(make_pair(0, source));
+	backwardHeap.push(make_pair(0, dest));
+
+	// best is the shortest complete path seen so far, through meet
+	int best = (source == dest) ? 0 : INFINITY;
+	int meet = (source == dest) ? source : -1;
+	for(;;) {
+		popStale(forwardHeap, forward);
+		popStale(backwardHeap, backward);
+		if(forwardHeap.empty() || backwardHeap.empty()) {
+			break;
+		}
+
+		// no unsettled vertex can lie on a path shorter than best
+		if(best != INFINITY && 
+			static_cast<long long>(forwardHeap.top().first) + backwardHeap.top().first >= best) {
+			break;
+		}
+
+		if(forwardHeap.top().first <= backwardHeap.top().first) {
+			searchStep(*csr, forwardHeap, forward, backward, best, meet);
+		} else {
+			searchStep(*reverseCsr, backwardHeap, backward, forward, best, meet);
+		}
+		result.m_settled++;
+	}
+
+	if(meet != -1) {
+		extractPath(forward, meet, result);
+		result.m_dist = best;
+		for(int vertex = backward.m_path[meet]; vertex != -1; vertex = backward.m_path[vertex]) {
+			result.m_path.push_back(vertex + 1);
+		}
+	}
+	forward.clear();
+	backward.clear();
+}
+
+
+// searchStep: queryBidirectional helper
+// settles the closest vertex in heap and relaxes its edges in csr. Any
+// vertex also reached by the opposite search, other, is a meeting point;
+// best and meet are updated when it gives a shorter complete path.
+// preconditions:	heap's top entry is not stale
+// postconditions:	one vertex settled in scratch; best and meet hold the
+//					shortest path seen through a meeting point
+//
+void Graph::searchStep(const CsrGraph &csr, MinHeap &heap, Scratch &scratch,
+	const Scratch &other, int &best, int &meet) {
+	const int *offsets = csr.getOffsets();
+	const int *adjVertices = csr.getAdjVertices();
+	const int *weights = csr.getWeights();
+	int dist = heap.top().first;
+	int vertex = heap.top().second;
+	heap.pop();
+	scratch.m_visited[vertex] = true;
+
+	for(int i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+		int adj = adjVertices[i];
+		int adjDist = Traits::add(dist, weights[i]);
+		if(!scratch.m_visited[adj] && adjDist < scratch.m_dist[adj]) {
+			scratch.reach(adj, adjDist, vertex);
+			heap.push(make_pair(adjDist, adj));
+			if(other.m_dist[adj] != INFINITY &&
+				static_cast<long long>(scratch.m_dist[adj]) + other.m_dist[adj] < best) {
+				best = scratch.m_dist[adj] + other.m_dist[adj];
+				meet = adj;
+			}
+		}
+	}
+}
+
+
+// popStale
+// removes entries from the top of heap whose vertex is already settled in
+// scratch or whose distance has since improved
+// preconditions:	none
+// postconditions:	heap is empty or its top entry is current
+//
+void Graph::popStale(MinHeap &heap, const Scratch &scratch) {
+	while(!heap.empty() && (scratch.m_visited[heap.top().second] ||
+		heap.top().first > scratch.m_dist[heap.top().second])) {
+		heap.pop();
+	}
+}
+
+
+// threadScratch
+// returns one of the calling thread's Scratch objects. Searches that run
+// two frontiers use index 0 forward and index 1 backward.
+// preconditions:	index is 0 or 1
+// postconditions:	returns a Scratch whose entries are all clean
+//
+Graph::Scratch &Graph::threadScratch(int index) {
+	static thread_local Scratch scratch[2];
+	return(scratch[index]);
+}
+
+
+// threadStats
+// returns the calling thread's SearchStats for the row it is computing
+// preconditions:	none
+// postconditions:	returns the thread's SearchStats
+//
+Graph::SearchStats &Graph::threadStats() {
+	static thread_local SearchStats stats;
+	return(stats);
+}
+
+
+// recordStats
+// adds the calling thread's SearchStats to m_stats and clears them
+// preconditions:	none
+// postconditions:	m_stats holds the thread's work; threadStats() is all
+//					zeros
+//
+void Graph::recordStats() const {
+	SearchStats &stats = threadStats();
+	lock_guard<mutex> lock(m_statsMutex);
+	m_stats.add(stats);
+	stats = SearchStats();
+}
+
+
+// lapStats
+// adds the seconds since the calling thread's last lapStats(...) call to
+// seconds, unless seconds is nullptr, and starts timing the next phase
+// preconditions:	none
+// postconditions:	*seconds is increased; the thread's clock is restarted
+//
+void Graph::lapStats(double *seconds) {
+	static thread_local chrono::steady_clock::time_point clock;
+	chrono::steady_clock::time_point now = chrono::steady_clock::now();
+	if(seconds != nullptr) {
+		*seconds += chrono::duration<double>(now - clock).count();
+	}
+	clock = now;
+}
+
+
+// extractPath
+// copies the path to dest recorded in scratch into result
+// preconditions:	scratch.m_visited[dest] is true
+// postconditions:	result.m_found = true; result.m_dist and result.m_path
+//					are set from scratch
+//
+void Graph::extractPath(const Scratch &scratch, int dest, PathResult &result) {
+	result.m_found = true;
+	result.m_dist = scratch.m_dist[dest];
+	result.m_path.clear();
+	for(int vertex = dest; vertex != -1; vertex = scratch.m_path[vertex]) {
+		result.m_path.push_back(vertex + 1);
+	}
+	reverse(result.m_path.begin(), result.m_path.end());
+}
+
+
+// pathLength
+// returns the number of vertices on the shortest path from source to dest,
+// or 0 if there is none, computing source's row of m_table if it is 
+// missing or out of date
+// preconditions:	source and dest must be index values
+// postconditions:	source's row is current; returns the path length
+//
+int Graph::pathLength(int source, int dest) const {
+	const int *row = getRow(source);
+	if(row[dest] == INFINITY) {
+		return(0);
+	}
+
+	int length = 1;
+	for(int vertex = dest; vertex != source; vertex = getPred(source, vertex)) {
+		length++;
+	}
+	return(length);
+}
+
+
+// displayPath
+// displays the vertices of path, separated by spaces
+// preconditions:	path holds length numerical-order values
+// postconditions:	the path is sent to the console
+//
+void Graph::displayPath(const int *path, int length) {
+	for(int i = 0; i < length; i++) {
+		if(i > 0) {
+			cout << " ";
+		}
+		cout << path[i];
 	}
 }
 
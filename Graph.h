@@ -6,49 +6,265 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <climits>
+#include <queue>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <list>
+#include <cstdint>
+#include <chrono>
+#include <mutex>
 #include "GraphData.h"
+#include "NodePool.h"
+#include "GraphLoader.h"
+#include "GraphFile.h"
+#include "CsrGraph.h"
+#include "Heuristics.h"
+#include "ThreadPool.h"
+#include "PriorityQueues.h"
+#include "BasicGraph.h"
 using namespace std;
 
 // Graph		Author: Sam Hoover
 //
 // Description:
 // A class representing a number, n, of single-source, weighted graphs, 
-// where 0 < n < 100. The primary purpose of this class is to build a graph and
+// where n > 0. The primary purpose of this class is to build a graph and
 // then perform Dijkstra's Algorithm on it to determine the shortest paths. The
-// graph's vertices and edges are stored in an adjacency list, m_vertices. All 
-// shortest paths are stored in a matrix of size 100x100, m_table, where each row
-// corresponds to one set of shortest paths, and each column corresponds to a 
-// vertex in the graph. 
+// graph's vertices and edges are stored in an adjacency list, m_vertices, sized
+// from the input. Shortest paths are stored in m_table, a cache of rows where
+// each row corresponds to one set of shortest paths from a single source, and
+// each column corresponds to a vertex in the graph. A row is computed the 
+// first time it is needed and kept until an edge change affects it or it is
+// evicted to stay within the row limit.
 //
 // Functionality:
 // A Graph object must be built from a properly formated file using the class's
-// buildGraph(ifsteam&) method. Once a Graph object is built, Edges can be 
-// inserted or removed, if they exist, using the insertEdge(int, int, int) and 
-// removeEdge(int, int) methods, respectively. Inserting an edge between two 
+// buildGraph(ifsteam&) method, or buildGraph(GraphLoader&) for large files. 
+// Once a Graph object is built, Edges can be inserted or removed, if they 
+// exist, using the insertEdge(int, int, int) and removeEdge(int, int) 
+// methods, respectively. Inserting an edge between two 
 // vertices where an edge already exists replaces the existing edge's weight
-// with the new edge's weight. Once a graph is built as desired, the
-// findShortestPath() method can be called to instantiate and fill the m_table
-// matrix. After findShortestPath() has been called, any changes to m_vertices 
-// will not be recorded in m_table until findShortestPath() is called again. When 
-// findShortestPath() has been called at least once, the shortest paths can be
-// displayed using the displayAll() and display(int, int) methods. The displayAll()
-// method displays all shortest paths, with each vertex as the source. The
-// display(int source, int dest) method displays a single shortest path from
-// source to dest, along with data stored at those locations. For display to 
-// show the most current shortest paths, findShortestPath() must be called
-// after any changes have been made to the graph.
+// with the new edge's weight. Edges already held in memory can be loaded 
+// in one pass, with the same rules, by insertEdges(const EdgeTriple*, int),
+// or used to build a whole graph by buildGraph(vector<string>, 
+// const EdgeTriple*, int).
+//
+// The shortest paths can be displayed using the displayAll() and 
+// display(int, int) methods, or returned as a PathResult by lookup(int, int).
+// getPath(int, int, int*, int) and getPathLocations(...) write a single 
+// shortest path into a buffer supplied by the caller instead, without
+// allocating; both display methods format the paths they return.
+// The displayAll() method displays all shortest paths, with each vertex as the
+// source. The display(int source, int dest) method displays a single shortest
+// path from source to dest, along with data stored at those locations. These
+// methods compute any row of m_table they need that is missing or out of 
+// date; findShortestPath() computes every row at once instead. Each row is 
+// stamped with the graph version, m_version, it is current for. m_version 
+// changes whenever the edges change, and insertEdge(int, int, int) and 
+// removeEdge(int, int) restamp every row the change cannot affect, so only
+// the affected rows are computed again. If setIncrementalRepair(true) has been
+// called, the affected rows are repaired in place instead: only the entries
+// whose shortest path uses the changed edge, or can now be shortened by it, 
+// are recomputed. setRowLimit(int) bounds the number of rows kept, evicting 
+// the least recently used row when a new one is needed.
+//
+// Edges and GraphData objects are not allocated one at a time; they are 
+// carved out of two NodePools owned by the Graph, m_edgePool and m_dataPool,
+// so that building a graph takes a few large allocations and emptying it 
+// returns every Edge at once instead of walking the linked lists. Once a
+// vertex has EDGE_INDEX_MIN edges, its linked list is indexed by an 
+// EdgeIndex hash table, so inserting, replacing or removing one of its 
+// edges no longer walks the list and building a high-degree vertex is not
+// quadratic in its degree.
+//
+// writeFile(string, bool) saves the graph, and optionally the current rows of
+// m_table, as a binary GraphFile; openFile(string) opens one again. Opening
+// a file maps it into memory and uses its edges in place as m_csr, so the 
+// Edge linked lists are only built if an edge is later inserted or removed.
+//
+// The algorithm used to pick the next vertex to visit can be selected at
+// runtime with setEngine(Engine), so that different engines can be compared on
+// the same graph. The engines do not walk the Edge linked lists directly; they
+// read a frozen CsrGraph copy of the edges, m_csr, which is rebuilt on demand
+// after the edges change and can be shared with other threads or Graph copies
+// through getCsr(). Because each row of m_table only depends on its own 
+// source, findShortestPath() can fill the rows on several threads at once; 
+// setThreadCount(int) selects how many. The threads live in a ThreadPool,
+// m_pool, that is started when first needed and reused by later searches
+// and edge changes, so they are not started again for every row. For graphs too large to search 
+// from many sources at once, the DELTA_STEPPING engine instead splits each
+// single-source search between the threads. When Graph is compiled with 
+// GRAPH_STATS defined, the engines count their work and time their phases
+// in a SearchStats, read with getSearchStats(); otherwise the counting code
+// is not compiled at all.
+//
+// A single shortest path can also be found without m_table by calling
+// query(int, int), which searches from source only until dest is reached.
+// query(int, int, QueryMode) can instead search from both ends at once, 
+// walking backward from dest over the transpose of m_csr, m_reverseCsr.
+// When the vertices carry coordinates, queryAStar(int, int, Heuristic) guides
+// the search toward dest with a distance estimate such as EuclideanHeuristic.
+// To serve these queries from many threads while the edges change, a
+// ConcurrentGraph publishes each change as a new, frozen copy of the Graph.
 //
 // Assumptions:	
 // This class assumes the following:
 //		-file input is entered in the proper format, as outlined in the HW3
-//		 assignment specification.
-//		-buildGraph(ifstream&) is called to properly build a Graph object
+//		 assignment specification. A vertex description may end with 
+//		 "@ x y" to give the vertex coordinates, e.g. "Zoo @ 47.66 -122.35".
+//		-buildGraph(ifstream&) or buildGraph(GraphLoader&) is called to 
+//		 properly build a Graph object
+//		-every shortest path is shorter than INFINITY; a path whose length
+//		 would reach INFINITY is treated as no path, and BasicGraph<int64_t>
+//		 holds the lengths of graphs whose paths are longer
 //
 class Graph {
 public:
-	static const int MAX_VERTICES = 100;
 	static const int INFINITY = INT_MAX;
 
+	// Engine
+	// the algorithm findShortestPath() uses to choose the next vertex to visit.
+	// LINEAR_SCAN scans a whole row of m_table for the lowest unvisited distance,
+	// costing O(V^2) per source. BINARY_HEAP keeps tentative distances in a
+	// binary min-heap with lazy deletion, costing O((V + E) log V) per source.
+	// Both engines visit vertices in the same order and fill m_table identically.
+	// FLOYD_WARSHALL fills every row of m_table at once with a cache-blocked
+	// Floyd-Warshall whose inner min-plus loop is vectorized, costing O(V^3) 
+	// in total; it gives the same distances, but where several shortest paths
+	// tie it may record a different one. Its distances are 32-bit with 
+	// INFINITY / 2 standing for no path, so if (V - 1) times the heaviest
+	// edge could reach INFINITY / 2 it falls back to BINARY_HEAP. AUTOMATIC
+	// uses FLOYD_WARSHALL when the graph has at least V^2 / AUTOMATIC_DENSITY
+	// edges and BINARY_HEAP otherwise. Rows computed one at a time on 
+	// demand, and all rows while a row limit smaller than V is set, always 
+	// use BINARY_HEAP unless the engine is LINEAR_SCAN, DELTA_STEPPING or 
+	// BUCKET_QUEUE. DELTA_STEPPING spreads each single-source search over 
+	// m_threadCount threads instead of running sources side by side: 
+	// tentative distances are grouped into buckets m_deltaWidth wide and 
+	// every vertex of the lowest bucket relaxes its edges in parallel. It 
+	// fills m_table identically to BINARY_HEAP.
+	// BUCKET_QUEUE is Dial's algorithm: BINARY_HEAP with the heap replaced by
+	// a BucketQueue, costing O(V + E + D) per source, where D is the longest
+	// shortest path. It fills m_table identically to BINARY_HEAP, and falls
+	// back to it when an edge is heavier than BUCKET_LIMIT.
+	//
+	enum Engine { LINEAR_SCAN, BINARY_HEAP, FLOYD_WARSHALL, AUTOMATIC, 
+		DELTA_STEPPING, BUCKET_QUEUE };
+
+	// AUTOMATIC picks FLOYD_WARSHALL for graphs with at least V^2 / 
+	// AUTOMATIC_DENSITY edges
+	static const int AUTOMATIC_DENSITY = 8;
+
+	// QueryMode
+	// the search query(int, int, QueryMode) runs. DIJKSTRA searches forward
+	// from source until dest is settled. BIDIRECTIONAL searches forward from
+	// source and backward from dest, always advancing the frontier with the
+	// smaller distance, and stops once the two frontiers cannot produce a 
+	// shorter path than the best one found where they meet. Both modes return
+	// the same distance.
+	//
+	enum QueryMode { DIJKSTRA, BIDIRECTIONAL };
+
+	// PathResult
+	// the answer to a single-pair query. m_found is false when there is no
+	// path from source to dest, in which case m_dist is INFINITY and m_path is
+	// empty. Otherwise m_dist is the length of the shortest path and m_path 
+	// holds the numerical-order values of its vertices, from source to dest.
+	// m_settled counts the vertices whose distance the search made final, in
+	// either direction, to compare the work done by each QueryMode.
+	//
+	struct PathResult {
+		// default constructor
+		// creates a PathResult representing no path
+		// preconditions:	none
+		// postconditions:	m_found = false; m_dist = INFINITY; m_path is empty;
+		//					m_settled = 0
+		//
+		PathResult();
+
+		bool m_found;
+		int m_dist;
+		vector<int> m_path;
+		int m_settled;
+	};
+
+	// EdgeTriple
+	// one edge given to insertEdges(...) or buildGraph(vector<string>, ...),
+	// from m_source to m_dest with weight m_cost. m_source and m_dest are
+	// numerical-order values (not index values).
+	//
+	struct EdgeTriple {
+		int m_source;
+		int m_dest;
+		int m_cost;
+	};
+
+	// SearchStats
+	// the work done computing rows of m_table since the last call to 
+	// resetSearchStats(). The counts are only gathered when Graph is 
+	// compiled with GRAPH_STATS defined; otherwise every field stays 0. 
+	// m_rows counts rows computed. For the BINARY_HEAP, BUCKET_QUEUE and
+	// LINEAR_SCAN engines, m_settled counts vertices whose distance became
+	// final, m_edgesScanned the edges leaving them, m_relaxations those edges
+	// that shortened a distance, and m_pushes and m_pops the queue operations
+	// (the LINEAR_SCAN engine has no queue). The seconds fields add up the 
+	// wall time spent resetting rows, searching, and setting predecessors 
+	// after the search, which only DELTA_STEPPING and, on graphs with an
+	// edge of weight 0, FLOYD_WARSHALL do. Rows computed at the same time on
+	// several threads each add their own time.
+	//
+	struct SearchStats {
+		// default constructor
+		// creates a SearchStats representing no work
+		// preconditions:	none
+		// postconditions:	every field is 0
+		//
+		SearchStats();
+
+		// add
+		// adds every field of stats to this
+		// preconditions:	none
+		// postconditions:	each field is the sum of its old value and stats'
+		//
+		void add(const SearchStats &stats);
+
+		long long m_rows;
+		long long m_settled;
+		long long m_edgesScanned;
+		long long m_relaxations;
+		long long m_pushes;
+		long long m_pops;
+		double m_resetSeconds;
+		double m_searchSeconds;
+		double m_pathSeconds;
+	};
+
+	// BatchResult
+	// the answers to queryBatch(pairs), kept in a few flat arrays instead of
+	// one PathResult per pair. m_dist[i] is the length of the shortest path
+	// for pairs[i], or INFINITY if there is none. Its vertices, by 
+	// numerical-order value from source to dest, are m_vertices[m_pathStart[i]]
+	// through m_vertices[m_pathStart[i + 1] - 1]; the path is empty if there
+	// is none. m_searches counts the searches run, one for each source whose
+	// row of m_table was not already current.
+	//
+	struct BatchResult {
+		// default constructor
+		// creates a BatchResult holding no answers
+		// preconditions:	none
+		// postconditions:	m_pathStart = { 0 }; m_searches = 0; the other
+		//					arrays are empty
+		//
+		BatchResult();
+
+		vector<int> m_dist;
+		vector<int> m_pathStart;
+		vector<int> m_vertices;
+		int m_searches;
+	};
+
 	// default constructor
 	// create a Graph object with m_size equal to 0
 	// preconditions:	none
@@ -66,6 +282,33 @@ public:
 	//
 	Graph(const Graph &graph);
 
+	// move constructor
+	// creates a Graph object that takes over the vertices, edges, m_table and
+	// settings of graph without copying them. It cannot throw, so containers
+	// of Graphs move their Graphs when they grow instead of copying them.
+	// preconditions:	none
+	// postconditions:	this holds graph's former contents; graph is empty
+	//
+	Graph(Graph &&graph) noexcept;
+
+	// assignment operator
+	// replaces the contents of this with those of graph. graph is a copy of
+	// the argument, or the argument itself moved in, so copy assignment makes
+	// a deep copy and move assignment copies nothing.
+	// preconditions:	none
+	// postconditions:	this holds what the argument held
+	//
+	Graph &operator=(Graph graph) noexcept;
+
+	// swap
+	// exchanges the vertices, edges, m_table and settings of this and graph
+	// in constant time
+	// preconditions:	none
+	// postconditions:	this holds graph's former contents and graph holds 
+	//					this's
+	//
+	void swap(Graph &graph) noexcept;
+
 	// destructor
 	// deletes the contents of m_vertices and sets m_size equal to 0
 	// preconditions:	none
@@ -82,6 +325,46 @@ public:
 	//
 	void buildGraph(ifstream &inFile);
 
+	// buildGraph(GraphLoader&)
+	// reads graph information from loader and sets this to the corresponding
+	// values, then calls loader.finish() so its stats cover the whole build.
+	// precondition:	loader must be open on a file properly formated to the
+	//					specifications in HW3.pdf and not yet read from.
+	// postconditions:	m_size set to the size read in from loader. m_vertices
+	//					set with the data and edges read in from loader.
+	//
+	void buildGraph(GraphLoader &loader);
+
+	// buildGraph(vector<string>, const EdgeTriple*, int)
+	// sets this to a graph with one vertex for each line of titles, which are
+	// read like the vertex description lines of a file, and the count edges
+	// in edges, loaded with insertEdges(...)
+	// preconditions:	edges holds count triples
+	// postconditions:	m_size = titles.size(); m_vertices set with the data in
+	//					titles and the edges in edges
+	//
+	void buildGraph(const vector<string> &titles, const EdgeTriple *edges, 
+		int count);
+
+	// writeFile
+	// saves the vertices and edges of this graph to fileName as a GraphFile,
+	// along with every current row of m_table if includeTable is true
+	// preconditions:	none
+	// postconditions:	returns true if fileName was written completely
+	//
+	bool writeFile(const string &fileName, bool includeTable = false) const;
+
+	// openFile
+	// replaces this graph with the one saved in fileName by writeFile. The 
+	// edges are read in place from the mapped file and any saved rows of
+	// m_table, up to the row limit, are current again.
+	// preconditions:	none
+	// postconditions:	returns true and sets m_size, m_vertices and m_csr 
+	//					from fileName if it is a valid GraphFile; otherwise
+	//					returns false and this graph is unchanged
+	//
+	bool openFile(const string &fileName);
+
 	// insertEdge
 	// inserts an edge into m_vertices[source]'s edge linked list with m_weight
 	// equal to cost and m_adjVertex equal to dest. If an edge from source to 
@@ -102,9 +385,31 @@ public:
 	//
 	void removeEdge(int source, int dest);
 
+	// insertEdges
+	// inserts the count edges in edges, leaving the graph as calling 
+	// insertEdge(int, int, int) for each triple in order would: invalid 
+	// triples are ignored, and when several triples share a source and dest,
+	// the last one's cost replaces the cost of any existing edge. Instead of a
+	// search of the edge list per triple, the triples are bucketed by source 
+	// with a counting sort, spread across m_threadCount threads, and each 
+	// source's list is then extended in one pass, so the cost is linear in 
+	// count plus the length of the lists touched. m_table is not updated edge 
+	// by edge; any row current before the call is computed again when next 
+	// used.
+	// preconditions:	edges holds count triples
+	// postconditions:	every valid triple's edge is in the graph, with the cost
+	//					of the last triple given for its source and dest
+	//
+	void insertEdges(const EdgeTriple *edges, int count);
+
 	// findShortestPath
 	// set m_table with the appropriate values of the shortest paths between
-	// each vertex, corresponding to the contents of m_vertices.
+	// each vertex, corresponding to the contents of m_vertices. Sources are
+	// handed out to m_threadCount threads, or, for FLOYD_WARSHALL, blocks of
+	// the table are; DELTA_STEPPING runs the sources one after another, each 
+	// on every thread. If a row limit smaller than the number of vertices is
+	// set, only the rows already in m_table are recomputed and the rest are
+	// left to be computed on demand.
 	// preconditions:	buildGraph has been called or m_size and m_vertices are
 	//					all set with valid information
 	// postconditions:	m_table's fields are set to the values corresponding to
@@ -112,8 +417,136 @@ public:
 	//
 	void findShortestPath();
 
+	// setEngine
+	// selects the algorithm used by findShortestPath()
+	// preconditions:	none
+	// postconditions:	m_engine = engine
+	//
+	void setEngine(Engine engine);
+
+	// getEngine
+	// returns the algorithm used by findShortestPath()
+	// preconditions:	none
+	// postconditions:	returns m_engine
+	//
+	Engine getEngine() const;
+
+	// setThreadCount
+	// sets the number of threads findShortestPath() uses to fill m_table. A
+	// threadCount less than 1 uses one thread per hardware core. The table
+	// produced is the same for every thread count. The threads are started
+	// the first time they are needed and kept until the count changes.
+	// preconditions:	none
+	// postconditions:	m_threadCount = threadCount, or the number of hardware
+	//					cores if threadCount < 1; m_pool is stopped if the 
+	//					count changed
+	//
+	void setThreadCount(int threadCount);
+
+	// getThreadCount
+	// returns the number of threads findShortestPath() uses to fill m_table
+	// preconditions:	none
+	// postconditions:	returns m_threadCount
+	//
+	int getThreadCount() const;
+
+	// setDeltaWidth
+	// sets the bucket width the DELTA_STEPPING engine groups tentative 
+	// distances by. Narrow buckets waste less work on distances that later
+	// improve; wide buckets give each parallel step more vertices. A 
+	// deltaWidth less than 1 picks the width from the edges each search: 
+	// the largest weight divided by the average number of edges per vertex.
+	// preconditions:	none
+	// postconditions:	m_deltaWidth = deltaWidth, or 0 if deltaWidth < 1
+	//
+	void setDeltaWidth(int deltaWidth);
+
+	// getDeltaWidth
+	// returns the bucket width of the DELTA_STEPPING engine, or 0 if it is
+	// picked from the edges
+	// preconditions:	none
+	// postconditions:	returns m_deltaWidth
+	//
+	int getDeltaWidth() const;
+
+	// getSearchStats
+	// returns the work done computing rows of m_table since the last call to
+	// resetSearchStats(), or all zeros if GRAPH_STATS was not defined
+	// preconditions:	no rows are being computed
+	// postconditions:	returns m_stats
+	//
+	SearchStats getSearchStats() const;
+
+	// resetSearchStats
+	// sets every field of the SearchStats to 0
+	// preconditions:	no rows are being computed
+	// postconditions:	m_stats is all zeros
+	//
+	void resetSearchStats();
+
+	// setIncrementalRepair
+	// turns incremental repair of m_table on or off. While it is on, 
+	// insertEdge(int, int, int) and removeEdge(int, int) update only the 
+	// entries of current rows that the edge change affects, leaving them with
+	// the same distances a call to findShortestPath() would produce. While it
+	// is off, rows the change affects are recomputed the next time they are
+	// needed.
+	// preconditions:	none
+	// postconditions:	m_incrementalRepair = enabled
+	//
+	void setIncrementalRepair(bool enabled);
+
+	// getIncrementalRepair
+	// returns true if incremental repair of m_table is on, else false
+	// preconditions:	none
+	// postconditions:	returns m_incrementalRepair
+	//
+	bool getIncrementalRepair() const;
+
+	// setRowLimit
+	// sets the most rows m_table keeps at once. When a row is needed and the
+	// limit is reached, the least recently used row is evicted. A rowLimit 
+	// less than 1 removes the limit, so m_table can hold every row.
+	// preconditions:	none
+	// postconditions:	m_rowLimit = rowLimit, or 0 if rowLimit < 1; rows past 
+	//					the limit are evicted, least recently used first
+	//
+	void setRowLimit(int rowLimit);
+
+	// getRowLimit
+	// returns the most rows m_table keeps at once, or 0 if there is no limit
+	// preconditions:	none
+	// postconditions:	returns m_rowLimit
+	//
+	int getRowLimit() const;
+
+	// getVersion
+	// returns the graph version, which changes whenever the edges change
+	// preconditions:	none
+	// postconditions:	returns m_version
+	//
+	unsigned long getVersion() const;
+
+	// getCsr
+	// returns a read-only compressed sparse row view of the current edges.
+	// The view is built from m_vertices the first time it is requested after
+	// a change to the edges and is shared until the edges change again.
+	// preconditions:	none
+	// postconditions:	returns m_csr, built from m_vertices if it was stale
+	//
+	shared_ptr<const CsrGraph> getCsr() const;
+
+	// getReverseCsr
+	// returns the transpose of getCsr(), listing each vertex's incoming edges.
+	// Built on demand and shared until the edges change, like getCsr().
+	// preconditions:	none
+	// postconditions:	returns m_reverseCsr, built from getCsr() if it was stale
+	//
+	shared_ptr<const CsrGraph> getReverseCsr() const;
+
 	// displayAll
-	// displays all shortest paths for all vertices in m_vertices
+	// displays all shortest paths for all vertices in m_vertices, computing 
+	// any row of m_table that is missing or out of date
 	// preconditions:	none
 	// postconditions:	all shortest paths for all vertices in m_vertices are
 	//					displayed to the console
@@ -121,13 +554,100 @@ public:
 	void displayAll() const;
 
 	// display
-	// displays the path, including Vertex title's, between source and dest
+	// displays the path, including Vertex title's, between source and dest,
+	// computing source's row of m_table if it is missing or out of date
 	// preconditions:	none
 	// postconditions:	the path, including Vertex title's, between source and 
 	//					dest is displayed to the console
 	//
 	void display(int source, int dest) const;
 
+	// query
+	// finds the shortest path from source to dest without using m_table, 
+	// using the search selected by mode. The search stops as soon as dest's
+	// distance is known to be final. Scratch state is kept per thread, so 
+	// concurrent queries on a Graph whose edges are not being changed are 
+	// safe once getCsr() and, for BIDIRECTIONAL, getReverseCsr() have been 
+	// called.
+	// preconditions:	source and dest must be the numerical-order value of the
+	//					vertices they represent (not the index value)
+	// postconditions:	returns the shortest path from source to dest, or a 
+	//					PathResult with m_found = false if there is none
+	//
+	PathResult query(int source, int dest, QueryMode mode = DIJKSTRA) const;
+
+	// lookup
+	// returns the shortest path from source to dest stored in source's row of
+	// m_table, computing the row first if it is missing or out of date. Later
+	// lookups from the same source are answered from the row without a search.
+	// preconditions:	source and dest must be the numerical-order value of the
+	//					vertices they represent (not the index value)
+	// postconditions:	returns the shortest path from source to dest, or a 
+	//					PathResult with m_found = false if there is none
+	//
+	PathResult lookup(int source, int dest) const;
+
+	// getPath
+	// writes the vertices of the shortest path from source to dest, by 
+	// numerical-order value from source to dest, into buffer, computing 
+	// source's row of m_table if it is missing or out of date. The path is 
+	// walked backward from dest with a loop, so long paths need no stack, and 
+	// nothing is allocated. If the path has more than capacity vertices, 
+	// buffer is left unchanged; calling again with a buffer of the returned 
+	// size gets the path.
+	// preconditions:	source and dest must be the numerical-order value of the
+	//					vertices they represent (not the index value); buffer 
+	//					holds at least capacity entries
+	// postconditions:	returns the number of vertices in the path, or 0 if 
+	//					there is none; if it is no more than capacity, buffer
+	//					holds the path
+	//
+	int getPath(int source, int dest, int *buffer, int capacity) const;
+
+	// getPathLocations
+	// writes the data, holding the title, of each vertex on the shortest path 
+	// from source to dest into buffer, the same way getPath(...) writes the 
+	// vertices. The pointers stay valid until the Graph is rebuilt or destroyed.
+	// preconditions:	source and dest must be the numerical-order value of the
+	//					vertices they represent (not the index value); buffer 
+	//					holds at least capacity entries
+	// postconditions:	returns the number of vertices in the path, or 0 if 
+	//					there is none; if it is no more than capacity, buffer
+	//					holds the path's data
+	//
+	int getPathLocations(int source, int dest, const GraphData **buffer, 
+		int capacity) const;
+
+	// queryBatch
+	// finds the shortest path for every (source, dest) pair in pairs. Pairs 
+	// are grouped by source, and each group is answered from source's row of
+	// m_table if it is current, or else by one search from source that stops
+	// once every dest of the group is settled. Groups are handed out to 
+	// m_threadCount threads. Concurrent calls are safe under the same 
+	// conditions as query(), as long as no other call is filling m_table.
+	// preconditions:	the pairs hold numerical-order values (not index values)
+	// postconditions:	returns the answers in pairs' order; a pair with an 
+	//					invalid vertex has no path
+	//
+	BatchResult queryBatch(const vector<pair<int, int> > &pairs) const;
+
+	// queryAStar
+	// finds the shortest path from source to dest with A* search, expanding
+	// vertices in order of their distance from source plus heuristic's 
+	// estimate of their distance to dest. Vertices are expanded again if a 
+	// shorter path to them is found later, so the result is a shortest path
+	// whenever heuristic never overestimates (is admissible). 
+	// result.m_settled counts expansions.
+	// preconditions:	source and dest must be the numerical-order value of the
+	//					vertices they represent (not the index value). 
+	//					heuristic(const GraphData&, const GraphData&) returns
+	//					a non-negative double.
+	// postconditions:	returns the shortest path from source to dest, or a 
+	//					PathResult with m_found = false if there is none
+	//
+	template <typename Heuristic>
+	PathResult queryAStar(int source, int dest, Heuristic heuristic) const;
+
 private:
 
 	// Edge
@@ -156,9 +676,88 @@ private:
 		Edge* m_nextEdge;
 	};
 
+	// EdgeIndex
+	// an index of one Vertex's edge linked list, so that finding, adding
+	// and unlinking an Edge takes O(1) expected time instead of a walk down
+	// the list. It is an open-addressing hash table with linear probing, 
+	// from each Edge's m_adjVertex to the Edge before it in the list 
+	// (nullptr for the first Edge), which is what unlinking needs. New
+	// Edges are appended after m_lastEdge, so the list keeps its order. A 
+	// list shorter than EDGE_INDEX_MIN is cheap to walk, so its index is not
+	// built until a walk finds the list has reached that length.
+	//
+	struct EdgeIndex {
+		// default constructor
+		// creates an EdgeIndex that has not been built
+		// preconditions:	none
+		// postconditions:	m_adjVertices and m_prevEdges are empty; m_count = 0; 
+		//					m_lastEdge = nullptr
+		//
+		EdgeIndex();
+
+		// isBuilt
+		// returns true if the index has been built, else false
+		// preconditions:	none
+		// postconditions:	returns true if m_adjVertices is not empty
+		//
+		bool isBuilt() const;
+
+		// build
+		// indexes every Edge in the linked list starting at head
+		// preconditions:	no two Edges in the list have the same m_adjVertex
+		// postconditions:	the index is built and holds every Edge in the list; 
+		//					m_lastEdge is the last of them
+		//
+		void build(Edge *head);
+
+		// find
+		// returns the slot holding the Edge to adj, or -1 if there is none
+		// preconditions:	the index is built
+		// postconditions:	returns the slot, or -1
+		//
+		int find(int adj) const;
+
+		// insert
+		// adds the Edge to adj, whose previous Edge in the list is prevEdge, 
+		// growing the table if it would become more than half full
+		// preconditions:	the index is built and holds no Edge to adj
+		// postconditions:	find(adj) returns a slot whose m_prevEdges entry is
+		//					prevEdge
+		//
+		void insert(int adj, Edge *prevEdge);
+
+		// erase
+		// removes the Edge in slot, moving later entries of its probe run back so
+		// that no slot is left marked as deleted
+		// preconditions:	slot was returned by find(...)
+		// postconditions:	the Edge is no longer indexed
+		//
+		void erase(int slot);
+
+		// slotOf
+		// returns the slot where the search for adj begins
+		// preconditions:	the table is not empty
+		// postconditions:	returns a slot of the table
+		//
+		int slotOf(int adj) const;
+
+		// resize
+		// moves every entry into a new, empty table of capacity slots
+		// preconditions:	capacity is a power of 2 greater than 2 * m_count
+		// postconditions:	the table holds capacity slots and the same entries
+		//
+		void resize(int capacity);
+
+		vector<int> m_adjVertices;	// -1 marks an empty slot
+		vector<Edge *> m_prevEdges;
+		int m_count;
+		Edge *m_lastEdge;
+	};
+
 	// Vertex
 	// represents a vertex in a weighted graph. Contains a pointer to a GraphData
-	// object and a pointer to an Edge representing the head of an edge linked list
+	// object and a pointer to an Edge representing the head of an edge linked list,
+	// along with that list's EdgeIndex
 	//
 	struct Vertex {
 		// default constructor
@@ -177,20 +776,137 @@ private:
 		Vertex(GraphData *data);
 		GraphData *m_data;
 		Edge *m_edgeHead;
+		EdgeIndex m_edgeIndex;
 	};
 
 	// Table
-	// represents the shortest path to a given vertex in a weighted graph.
-	// 
+	// the shortest paths stored in m_table, kept as separate arrays so that
+	// a row of distances is scanned without touching the predecessors. The
+	// row in slot s is at positions s * m_size through s * m_size + m_size - 1
+	// of each array. m_dist is INFINITY for a vertex with no path from the 
+	// row's source. Predecessors are index values, and the source is its own
+	// predecessor; they are kept in 16 bits, in m_smallPred, when every index
+	// fits (m_size <= SMALL_PRED_LIMIT) and in m_pred otherwise. Whether a
+	// vertex has been visited is only needed while a row is being computed,
+	// so it is not stored.
+	//
 	struct Table {
-		bool m_visited;
-		int m_path;
-		int m_dist;
+		vector<int> m_dist;
+		vector<uint16_t> m_smallPred;
+		vector<int> m_pred;
+	};
+
+	// largest m_size whose predecessor index values fit in m_smallPred
+	static const int SMALL_PRED_LIMIT = 65536;
+
+	// findShortestPathFloyd stands for no path with FLOYD_INFINITY, so that
+	// adding two distances cannot overflow, and works on blocks of 
+	// FLOYD_BLOCK x FLOYD_BLOCK entries
+	static const int FLOYD_INFINITY = INT_MAX / 2;
+	static const int FLOYD_BLOCK = 64;
+
+	// findShortestPathDelta hands out the vertices of each parallel step in
+	// chunks of DELTA_CHUNK
+	static const int DELTA_CHUNK = 256;
+
+	// fewest affected rows updateTable repairs on more than one thread
+	static const int REPAIR_PARALLEL_MIN = 16;
+
+	// shortest edge list whose EdgeIndex is built
+	static const int EDGE_INDEX_MIN = 16;
+
+	// heaviest edge the BUCKET_QUEUE engine takes; heavier edges would make
+	// it pass over too many empty buckets, so BINARY_HEAP is used instead
+	static const int BUCKET_LIMIT = 4096;
+
+	// Traits
+	// the int specialization BasicGraph uses. Every search adds distances with
+	// Traits::add, which returns INFINITY instead of overflowing, so a path too
+	// long to hold in an int is never shorter than one that is not.
+	//
+	typedef WeightTraits<int> Traits;
+
+	// MinHeap
+	// a min-heap of (distance, vertex index) pairs used by the BINARY_HEAP
+	// engine. Entries are never decreased in place; a vertex is pushed again
+	// whenever its distance improves and stale entries are skipped when popped.
+	//
+	typedef priority_queue<pair<int, int>, vector<pair<int, int> >,
+		greater<pair<int, int> > > MinHeap;
+
+	// AStarHeap
+	// a min-heap of (estimated total distance, (distance, vertex index)) 
+	// entries used by queryAStar. Stale entries are skipped like in MinHeap.
+	//
+	typedef pair<double, pair<int, int> > AStarEntry;
+	typedef priority_queue<AStarEntry, vector<AStarEntry>, 
+		greater<AStarEntry> > AStarHeap;
+
+	// Scratch
+	// per-thread working state for searches that do not write to m_table.
+	// Between searches every entry is clean (m_dist = INFINITY, m_path = -1,
+	// m_visited = false); a search records each vertex it changes in 
+	// m_touched so that clear() only resets those entries.
+	//
+	struct Scratch {
+		// prepare
+		// grows the arrays to hold at least size vertices
+		// preconditions:	all entries are clean
+		// postconditions:	m_dist, m_path and m_visited hold at least size
+		//					clean entries
+		//
+		void prepare(int size);
+
+		// reach
+		// records a new tentative distance and predecessor for vertex
+		// preconditions:	vertex is less than the prepared size
+		// postconditions:	m_dist[vertex] = dist; m_path[vertex] = path
+		//
+		void reach(int vertex, int dist, int path);
+
+		// clear
+		// resets every entry changed since the last clear()
+		// preconditions:	none
+		// postconditions:	all entries are clean and m_touched is empty
+		//
+		void clear();
+
+		vector<int> m_dist;
+		vector<int> m_path;		// predecessor index value, -1 for none
+		vector<char> m_visited;
+		vector<int> m_touched;
 	};
 
 	int m_size;
-	Vertex m_vertices[MAX_VERTICES];
-	Table m_table[MAX_VERTICES][MAX_VERTICES];
+	Engine m_engine;
+	int m_threadCount;
+	int m_deltaWidth;			// DELTA_STEPPING bucket width, 0 to pick it
+	bool m_incrementalRepair;
+	int m_rowLimit;				// most rows kept in m_table, 0 for no limit
+	unsigned long m_version;	// incremented whenever the edges change
+	vector<Vertex> m_vertices;
+	bool m_edgesInCsr;		// true if the Edge lists are not built from m_csr yet
+	NodePool<Edge> m_edgePool;			// every Edge in m_vertices
+	NodePool<GraphData> m_dataPool;		// every GraphData in m_vertices
+
+	// m_table is a cache of rows. Each slot holds m_size entries for one source.
+	mutable Table m_table;
+	mutable vector<int> m_rowSlot;			// source -> slot, -1 if not cached
+	mutable vector<int> m_slotSource;		// slot -> source
+	mutable vector<unsigned long> m_slotVersion;	// m_version the slot is current for
+	mutable list<int> m_recentRows;			// cached sources, most recent first
+	mutable vector<list<int>::iterator> m_recentPosition;	// source -> m_recentRows entry
+	mutable shared_ptr<const CsrGraph> m_csr;	// nullptr when stale
+	mutable shared_ptr<const CsrGraph> m_reverseCsr;	// nullptr when stale
+
+	// m_incoming[v] holds the (source, weight) of every edge into v, for the
+	// repairs of updateTable; it matches the edges while m_incomingVersion 
+	// = m_version
+	vector<vector<pair<int, int> > > m_incoming;
+	unsigned long m_incomingVersion;
+	mutable unique_ptr<ThreadPool> m_pool;	// nullptr until threads are needed
+	mutable SearchStats m_stats;	// only gathered if GRAPH_STATS is defined
+	mutable mutex m_statsMutex;		// guards m_stats while threads record
 
 
 	// copyVertices: copy constructor helper
@@ -203,105 +919,512 @@ private:
 
 	// copyEdge: copyVertives helper
 	// to becomes a new Edge with m_weight, m_adjVertex, and m_nextEdge equal
-	// to the corresponding values in from.
+	// to the corresponding values in from. The list is copied in a loop, so
+	// long lists cannot overflow the stack.
 	// preconditions:	none
 	// postconditions:	to becomes an identical copy of from
 	//
 	void copyEdge(Edge *&to, Edge *from);
 
 	// copyTable: copy contructor helper
-	// copies all data in graph.m_table to m_table
+	// copies all rows in graph.m_table, and their slots, versions and order of
+	// use, to m_table
 	// preconditions:	graph must be a valid Graph object (must not reference a
 	//					dereferenced nullptr)
 	// postconditions:	m_table = graph.m_table
 	//
 	void copyTable(const Graph &graph);
 
+	// buildCsr
+	// packs the Edge linked lists in m_vertices into a new CsrGraph
+	// preconditions:	none
+	// postconditions:	returns a CsrGraph holding every edge in m_vertices
+	//
+	shared_ptr<const CsrGraph> buildCsr() const;
+
+	// getPool
+	// returns the ThreadPool of m_threadCount threads that findShortestPath(),
+	// updateTable(...) and the row searches share, starting it the first time
+	// it is needed, the way getCsr() builds m_csr
+	// preconditions:	not called while a loop is running on m_pool
+	// postconditions:	returns *m_pool, started if it was nullptr
+	//
+	ThreadPool &getPool() const;
+
+	// loadEdges
+	// builds the Edge linked lists in m_vertices from m_csr after openFile
+	// preconditions:	m_edgesInCsr is true, so m_csr holds every edge
+	// postconditions:	m_vertices holds every edge in m_csr, in the same
+	//					order; m_edgesInCsr = false
+	//
+	void loadEdges();
+
+	// readData: buildGraph helper
+	// creates the GraphData for one vertex description line. A line ending in
+	// "@ x y" gives the vertex coordinates; the title is the text before '@'.
+	// preconditions:	none
+	// postconditions:	returns a new GraphData for line
+	//
+	GraphData *readData(const string &line);
+
+	// edgesChanged
+	// discards everything derived from the edges in m_vertices and starts a
+	// new graph version
+	// preconditions:	none
+	// postconditions:	m_csr = nullptr; m_reverseCsr = nullptr; m_version is
+	//					incremented
+	//
+	void edgesChanged();
+
 	// empty
-	// removes all data from m_vertices and sets all pointers to nullptr
+	// removes all data from m_vertices and sets all pointers to nullptr. Edges
+	// need no destructor, so they are returned with their pool's chunks rather
+	// than one at a time; each GraphData is destroyed since it owns a string.
 	// preconditions:	none
 	// postconditions:	all data from m_vertices removed and pointers set to nullptr
 	//
 	void empty();
 
 	// insertEdge helper
-	// inserts an edge into m_vertices[]'s edge linked list with m_weight
-	// equal to cost and m_adjVertex equal to dest. If an edge from source to 
-	// dest already exists, than that edge's m_weight is set to cost.
-	// preconditions:	source and dest must be the numerical-order value of the
-	//					edge's they represent (not the index value)
+	// inserts an edge into vertex's edge linked list with m_weight equal to 
+	// cost and m_adjVertex equal to dest. If an edge from vertex to dest 
+	// already exists, than that edge's m_weight is set to cost.
+	// preconditions:	dest must be the numerical-order value of the vertex it
+	//					represents (not the index value)
 	// postconditions:	a new Edge with m_weight = cost and m_adjVertex = dest is
-	//					inserted into m_vertices[]'s edge linked list
+	//					appended to vertex's edge linked list
+	//
+	void insertEdge(int dest, int cost, Vertex &vertex);
+
+	// findLink
+	// returns the link, either vertex.m_edgeHead or some Edge's m_nextEdge, 
+	// that points to vertex's Edge to adj, or the nullptr link at the end of 
+	// the list if there is none. The list is walked until it reaches 
+	// EDGE_INDEX_MIN Edges; from then on its EdgeIndex is used.
+	// preconditions:	adj must be an index value
+	// postconditions:	returns the link; vertex.m_edgeIndex is built if the 
+	//					list has at least EDGE_INDEX_MIN Edges
+	//
+	Edge **findLink(Vertex &vertex, int adj);
+
+	// sortBySource: insertEdges helper
+	// sorts the valid triples in edges by source with a stable counting sort.
+	// Each of up to m_threadCount threads counts the sources in one chunk of
+	// edges, and then places that chunk's triples after those of every earlier
+	// chunk with the same source, so triples with the same source stay in 
+	// the order given.
+	// preconditions:	edges holds count triples
+	// postconditions:	offsets holds m_size + 1 entries; edges[order[i]] for i
+	//					from offsets[v] through offsets[v + 1] - 1 are the valid
+	//					triples from index value v, in the order given
 	//
-	void insertEdge(int dest, int cost, Edge *&edge);
+	void sortBySource(const EdgeTriple *edges, int count, vector<int> &offsets,
+		vector<int> &order) const;
 	
 	// findShortestPath helper
-	// set m_table with the appropriate values of the shortest paths between
-	// each vertex, corresponding to the contents of m_vertices.
-	// preconditions:	buildGraph has been called or m_size and m_vertices are
-	//					all set with valid information
-	// postconditions:	m_table's fields are set to the values corresponding to
-	//					the shortest path's between vertices
+	// set source's row of m_table with the appropriate values of the shortest
+	// paths from source, corresponding to the contents of m_vertices. 
+	// DELTA_STEPPING runs the search on the threads of getPool().
+	// preconditions:	source must be the index value of a vertex with a slot
+	//					in m_table. m_csr must be current. For DELTA_STEPPING, 
+	//					it is not called from a task running on getPool().
+	// postconditions:	source's row is reset, then set to the values 
+	//					corresponding to the shortest paths from source
 	//
-	void findShortestPath(int source);
+	void findShortestPath(int source) const;
 
-	// findLowestMove
-	// finds the next shortest path in m_table
+	// getRow
+	// returns source's row of m_table, computing it first if it is missing or
+	// out of date, and marks it most recently used
 	// preconditions:	source must be the index value of the desired source vertex
-	// postconditions:	returns an in representing the shortest path in m_table
+	// postconditions:	returns a pointer to the m_size distances of source's 
+	//					row
+	//
+	const int *getRow(int source) const;
+
+	// isCurrent
+	// returns true if source has a row in m_table that is current for m_version
+	// preconditions:	source must be the index value of the desired source vertex
+	// postconditions:	returns true if source's row is cached and current
+	//
+	bool isCurrent(int source) const;
+
+	// assignSlot
+	// gives source a slot in m_table, evicting the least recently used row if
+	// the row limit has been reached
+	// preconditions:	source must be the index value of a vertex without a slot
+	// postconditions:	source has a slot and is the most recently used row
+	//
+	void assignSlot(int source) const;
+
+	// evictRow
+	// removes the least recently used row from m_table
+	// preconditions:	m_recentRows is not empty
+	// postconditions:	the least recently used source no longer has a slot
+	//
+	void evictRow() const;
+
+	// rowCapacity
+	// returns the most rows m_table may hold for the current m_size
+	// preconditions:	none
+	// postconditions:	returns m_size, or m_rowLimit if it is smaller and set
+	//
+	int rowCapacity() const;
+
+	// findWeight
+	// returns the weight of the edge from source to dest
+	// preconditions:	source and dest must be the index values of the desired
+	//					vertices
+	// postconditions:	returns the edge's m_weight, or INFINITY if there is no
+	//					edge from source to dest
+	//
+	int findWeight(int source, int dest) const;
+
+	// updateTable
+	// brings m_table up to date after the edge from source to dest changed 
+	// from oldCost to newCost (INFINITY meaning no edge) and m_version was 
+	// incremented. Every row that was current before the change and that the
+	// change cannot affect is restamped with m_version. Affected rows are
+	// repaired and restamped if incremental repair is on, otherwise they are
+	// left out of date. The repairs run on m_threadCount threads only when 
+	// at least REPAIR_PARALLEL_MIN rows are affected, since starting the 
+	// threads costs more than a few repairs. They read the Edge lists in 
+	// m_vertices and the incoming edges in m_incoming, which is patched for
+	// the changed edge rather than rebuilt, so neither m_csr nor 
+	// m_reverseCsr is rebuilt for them.
+	// preconditions:	source and dest must be the index values of the changed
+	//					edge's vertices. The Edge lists in m_vertices hold the
+	//					edges after the change.
+	// postconditions:	every row current before the change is current again,
+	//					except affected rows when incremental repair is off
+	//
+	void updateTable(int source, int dest, int oldCost, int newCost);
+
+	// isAffected: updateTable helper
+	// returns true if changing the edge from -> to from oldCost to newCost 
+	// can change row's distances or predecessors
+	// preconditions:	row, from and to must be index values. row is current
+	//					for the edges before the change.
+	// postconditions:	returns true if row must be repaired or recomputed
+	//
+	bool isAffected(int row, int from, int to, int oldCost, int newCost) const;
+
+	// repairDecrease: updateTable helper
+	// repairs row of m_table after the edge from -> to was added or made
+	// cheaper with weight cost. Starting at to, only vertices whose distance
+	// becomes shorter are revisited, through the Edge lists in m_vertices.
+	// preconditions:	row, from and to must be index values. row is current
+	//					for the edges before the change. The Edge lists hold
+	//					the edges after the change.
+	// postconditions:	row is current for the edges after the change
 	//
-	int findLowestMove(int source) const;
+	void repairDecrease(int row, int from, int to, int cost);
+
+	// repairIncrease: updateTable helper
+	// repairs row of m_table after the edge from -> to was removed or made 
+	// more expensive. If the edge is on row's shortest path to to, every 
+	// vertex whose path passes through it is reset and searched again from
+	// its unaffected neighbors, found in m_incoming.
+	// preconditions:	row, from and to must be index values. row is current
+	//					for the edges before the change. The Edge lists and 
+	//					m_incoming hold the edges after the change.
+	// postconditions:	row is current for the edges after the change
+	//
+	void repairIncrease(int row, int from, int to);
+
+	// buildIncoming: updateTable helper
+	// fills m_incoming from the Edge lists in m_vertices
+	// preconditions:	the Edge lists hold every edge (m_edgesInCsr is false)
+	// postconditions:	m_incoming[v] holds every edge into v; m_incomingVersion
+	//					= m_version
+	//
+	void buildIncoming();
+
+	// patchIncoming: updateTable helper
+	// changes the weight of the edge from -> to in m_incoming to newCost, 
+	// adding the edge if it is missing or removing it if newCost is INFINITY
+	// preconditions:	from and to must be index values
+	// postconditions:	m_incoming[to] holds (from, newCost) once, or no entry
+	//					from from if newCost is INFINITY
+	//
+	void patchIncoming(int from, int to, int newCost);
+
+	// findShortestPathQueue: findShortestPath helper
+	// set m_table[source] with the shortest paths from source using queue, a
+	// MinHeap or BucketQueue, to choose the next vertex to visit. Queue is a
+	// template parameter so the search loop calls the queue directly.
+	// preconditions:	source must be the index value of the desired source vertex.
+	//					m_table[source] must be reset. queue is empty.
+	// postconditions:	m_table[source]'s fields are set to the values corresponding
+	//					to the shortest paths from source
+	//
+	template <typename Queue>
+	void findShortestPathQueue(int source, Queue &queue) const;
+
+	// findShortestPathDelta: findShortestPath helper
+	// set m_table[source] with the shortest paths from source by delta-stepping
+	// on the threads of pool. Tentative distances live in an array of atomics
+	// that any thread lowers with compare-and-swap. Vertices wait in buckets of
+	// tentative distances delta wide; the lowest bucket is emptied in rounds 
+	// that relax every edge of weight at most delta leaving its vertices in
+	// parallel, and once it is empty the heavier edges of every vertex settled
+	// in it are relaxed in parallel too. The predecessors are then set by 
+	// setSettledPreds().
+	// preconditions:	source must be the index value of the desired source vertex.
+	//					m_table[source] must be reset. m_csr must be current.
+	// postconditions:	m_table[source]'s fields are set to the values corresponding
+	//					to the shortest paths from source, the same as 
+	//					findShortestPathQueue(source, queue) sets
+	//
+	void findShortestPathDelta(int source, ThreadPool &pool) const;
+
+	// setSettledPreds: findShortestPathDelta helper
+	// sets the predecessors in source's row of m_table from its final 
+	// distances, choosing for each vertex the same one visitVertex() would: 
+	// the first vertex settled, in (distance, index value) order, with an edge
+	// lying on a shortest path to it. Without edges of weight 0 every vertex 
+	// picks among its incoming edges in m_reverseCsr on its own, in parallel.
+	// Otherwise the order vertices are settled in depends on the search, so it
+	// is replayed with a MinHeap over the edges lying on shortest paths.
+	// preconditions:	source's distances are final; zeroWeight is true if any
+	//					edge has weight 0
+	// postconditions:	every reached vertex in source's row has its predecessor
+	//					set
+	//
+	void setSettledPreds(int source, bool zeroWeight, ThreadPool &pool) const;
+
+	// usesFloydWarshall: findShortestPath helper
+	// returns true if findShortestPath() should fill m_table with 
+	// findShortestPathFloyd() for the current engine, edges and row limit
+	// preconditions:	m_csr is current
+	// postconditions:	returns true for FLOYD_WARSHALL, or for AUTOMATIC on
+	//					a dense graph, when every row fits in m_table and no
+	//					simple path can be as long as FLOYD_INFINITY
+	//
+	bool usesFloydWarshall() const;
+
+	// findShortestPathFloyd: findShortestPath helper
+	// sets every row of m_table with a blocked Floyd-Warshall. The distances
+	// are split into FLOYD_BLOCK x FLOYD_BLOCK blocks; for each diagonal 
+	// block, the block itself is updated first, then its row and column of
+	// blocks, then all remaining blocks, each step handing blocks to 
+	// m_threadCount threads. Predecessors are updated along with distances, 
+	// except that if the graph has an edge of weight 0 they are set afterwards
+	// row by row with setTightPreds(), since ties along such edges could 
+	// otherwise leave a predecessor chain that loops without reaching source.
+	// preconditions:	m_csr is current; rowCapacity() = m_size; shortest 
+	//					path lengths are less than FLOYD_INFINITY
+	// postconditions:	every row of m_table is set and current
+	//
+	void findShortestPathFloyd();
+
+	// updateBlock: findShortestPathFloyd helper
+	// relaxes the block of rows starting at rowBlock and columns starting at
+	// columnBlock through every vertex of the block starting at pivotBlock
+	// preconditions:	dist and pred are m_size x m_size matrices; the block
+	//					starts are multiples of FLOYD_BLOCK
+	// postconditions:	dist[i][j] = min(dist[i][j], dist[i][k] + dist[k][j])
+	//					over the block, with pred updated to match
+	//
+	void updateBlock(int *dist, int *pred, int rowBlock, int columnBlock,
+		int pivotBlock) const;
+
+	// minPlusRow: updateBlock helper
+	// for j < count, sets distI[j] to distIK + distK[j] and predI[j] to 
+	// predK[j] wherever that is shorter. Uses AVX2 when compiled for it and
+	// a loop the compiler can vectorize otherwise.
+	// preconditions:	each array holds count entries; distIK < FLOYD_INFINITY
+	//					and distK[j] <= FLOYD_INFINITY
+	// postconditions:	distI[j] = min(distI[j], distIK + distK[j])
+	//
+	static void minPlusRow(int distIK, const int *distK, const int *predK,
+		int *distI, int *predI, int count);
+
+	// setTightPreds: findShortestPathFloyd helper
+	// sets the predecessors in source's row of m_table from its distances
+	// with a breadth-first search from source that follows only edges lying
+	// on a shortest path, so that every predecessor chain leads back to 
+	// source even across edges of weight 0
+	// preconditions:	source has a slot whose distances are final, with 
+	//					FLOYD_INFINITY standing for no path; queue holds 
+	//					m_size entries
+	// postconditions:	source's row of m_table is set, with INFINITY 
+	//					standing for no path
+	//
+	void setTightPreds(int source, int *queue) const;
+
+	// queryDijkstra: query helper
+	// searches forward from source until dest is settled
+	// preconditions:	source and dest must be the index values of the desired
+	//					vertices
+	// postconditions:	result holds the shortest path from source to dest
+	//
+	void queryDijkstra(int source, int dest, PathResult &result) const;
+
+	// answerGroup: queryBatch helper
+	// answers the count pairs whose indices are order[0] through 
+	// order[count - 1], which share one source and are sorted by dest. The 
+	// answers come from source's row of m_table if it is current, or else from
+	// a search that stops once every dest is settled. Sets result.m_dist and 
+	// pathLength for each pair and appends its path, from source to dest, to
+	// paths.
+	// preconditions:	the pairs hold valid numerical-order values; getCsr() has
+	//					been called
+	// postconditions:	returns true if a search was run, false if the row of
+	//					m_table was used
+	//
+	bool answerGroup(const vector<pair<int, int> > &pairs, const int *order,
+		int count, BatchResult &result, vector<int> &pathLength, 
+		vector<int> &paths) const;
+
+	// queryBidirectional: query helper
+	// searches forward from source and backward from dest until the 
+	// frontiers meet on a shortest path
+	// preconditions:	source and dest must be the index values of the desired
+	//					vertices
+	// postconditions:	result holds the shortest path from source to dest
+	//
+	void queryBidirectional(int source, int dest, PathResult &result) const;
+
+	// searchStep: queryBidirectional helper
+	// settles the closest vertex in heap and relaxes its edges in csr. Any
+	// vertex also reached by the opposite search, other, is a meeting point;
+	// best and meet are updated when it gives a shorter complete path.
+	// preconditions:	heap's top entry is not stale
+	// postconditions:	one vertex settled in scratch; best and meet hold the
+	//					shortest path seen through a meeting point
+	//
+	static void searchStep(const CsrGraph &csr, MinHeap &heap, Scratch &scratch,
+		const Scratch &other, int &best, int &meet);
+
+	// popStale
+	// removes entries from the top of heap whose vertex is already settled in
+	// scratch or whose distance has since improved
+	// preconditions:	none
+	// postconditions:	heap is empty or its top entry is current
+	//
+	static void popStale(MinHeap &heap, const Scratch &scratch);
+
+	// threadScratch
+	// returns one of the calling thread's Scratch objects. Searches that run
+	// two frontiers use index 0 forward and index 1 backward.
+	// preconditions:	index is 0 or 1
+	// postconditions:	returns a Scratch whose entries are all clean
+	//
+	static Scratch &threadScratch(int index = 0);
+
+	// threadStats
+	// returns the calling thread's SearchStats for the row it is computing
+	// preconditions:	none
+	// postconditions:	returns the thread's SearchStats
+	//
+	static SearchStats &threadStats();
+
+	// recordStats
+	// adds the calling thread's SearchStats to m_stats and clears them
+	// preconditions:	none
+	// postconditions:	m_stats holds the thread's work; threadStats() is all
+	//					zeros
+	//
+	void recordStats() const;
+
+	// lapStats
+	// adds the seconds since the calling thread's last lapStats(...) call to
+	// seconds, unless seconds is nullptr, and starts timing the next phase
+	// preconditions:	none
+	// postconditions:	*seconds is increased; the thread's clock is restarted
+	//
+	static void lapStats(double *seconds);
+
+	// extractPath
+	// copies the path to dest recorded in scratch into result
+	// preconditions:	scratch.m_visited[dest] is true
+	// postconditions:	result.m_found = true; result.m_dist and result.m_path
+	//					are set from scratch
+	//
+	static void extractPath(const Scratch &scratch, int dest, PathResult &result);
+
+	// findLowestMove
+	// finds the unvisited vertex with the lowest distance in source's row
+	// preconditions:	source must be the index value of the desired source
+	//					vertex. visited holds m_size entries.
+	// postconditions:	returns the index value of that vertex, or INFINITY if
+	//					every reachable vertex has been visited
+	//
+	int findLowestMove(int source, const char *visited) const;
 
 	// setSource
-	// sets the source vetex's values and nest shortest paths in m_table.
+	// sets the source vertex's distance and predecessor in m_table
 	// preconditions:	source must be the index value of the desired source vertex
-	// postconditions:	m_table[source][source].m_visited = true, 
-	//					m_table[source][source].m_path = 0,
-	//					m_table[source][source].m_dist = 0. 
+	// postconditions:	source's distance is 0 and it is its own predecessor
 	//
-	void setSource(int source);
+	void setSource(int source) const;
 
 	// visitVertex
-	// marks m_table[source][dest].m_visited as true and sets any new shortest
-	// paths in m_table
+	// sets any new shortest paths in source's row of m_table through the 
+	// edges leaving dest. If queue is not nullptr, every vertex whose distance
+	// improves is pushed onto queue.
 	// preconditions:	source and dest must be the index value of the desired 
-	//					vertices
-	// postconditions:	m_table[source][dest].m_visited = true; any new shortest
-	//					paths set in m_table
+	//					vertices. dest's distance is final.
+	// postconditions:	any new shortest paths set in m_table and pushed onto
+	//					queue
 	//
-	void visitVertex(int source, int dest);
+	template <typename Queue>
+	void visitVertex(int source, int dest, Queue *queue) const;
 
 	// resetTable
-	// for all cells in m_table, sets m_visited to false, and m_path and m_dist
-	// to INFINITY
+	// removes every row from m_table
 	// preconditions:	none
-	// postconditions:	for all cells in m_table, m_visited = false, m_path = 
-	//					INFINITY, m_dist = INFINITY
+	// postconditions:	m_table is empty and no source has a slot
 	//
-	void resetTable();
+	void resetTable() const;
 
-	// displayPath
-	// displays the shortest path from source to dest.
-	// preconditions:	source must be the index value of the desired source vertex
-	// postconditions:	shortest path from source to dest sent to console
+	// resetRow
+	// sets every distance in source's row of m_table to INFINITY
+	// preconditions:	source must be the index value of a vertex with a slot
+	// postconditions:	every vertex in source's row has no path
 	//
-	void displayPath(int source, int dest) const;
+	void resetRow(int source) const;
 
-	// displayPathHelper
-	// displays the shortest path from source to dest.
-	// preconditions:	source must be the index value of the desired source vertex
-	// postconditions:	shortest path from source to dest sent to console
+	// distRow
+	// returns the distances in source's row of m_table
+	// preconditions:	source must be the index value of a vertex with a slot
+	// postconditions:	returns a pointer to the m_size distances of the row
 	//
-	void displayPathHelper(int source, int dest) const;
+	int *distRow(int source) const;
 
-	// displayLocations
-	// displays the titles of locations visited in the shortest path between source
-	// and dest
-	// preconditions:	source must be the index value of the desired source vertex
-	// postconditions:	locations visited in shortest path between source and dest sent
-	//					to console
+	// getPred
+	// returns the predecessor of dest on the shortest path from source
+	// preconditions:	source and dest must be index values. source must have
+	//					a slot and a path to dest.
+	// postconditions:	returns the predecessor's index value, or source if
+	//					dest = source
+	//
+	int getPred(int source, int dest) const;
+
+	// setPred
+	// sets the predecessor of dest on the shortest path from source
+	// preconditions:	source, dest and pred must be index values. source must
+	//					have a slot.
+	// postconditions:	getPred(source, dest) = pred
+	//
+	void setPred(int source, int dest, int pred) const;
+
+	// pathLength
+	// returns the number of vertices on the shortest path from source to dest,
+	// or 0 if there is none, computing source's row of m_table if it is 
+	// missing or out of date
+	// preconditions:	source and dest must be index values
+	// postconditions:	source's row is current; returns the path length
+	//
+	int pathLength(int source, int dest) const;
+
+	// displayPath
+	// displays the vertices of path, separated by spaces
+	// preconditions:	path holds length numerical-order values
+	// postconditions:	the path is sent to the console
 	//
-	void displayLocations(int source, int dest) const;
+	static void displayPath(const int *path, int length);
 
 	// displayHeader: DisplayAll Helper
 	// Displays a header containing the field names for the fields displayed in the
@@ -312,4 +1435,73 @@ private:
 	void displayHeader() const;
 };
 
+
+// queryAStar
+// finds the shortest path from source to dest with A* search, expanding
+// vertices in order of their distance from source plus heuristic's 
+// estimate of their distance to dest. Vertices are expanded again if a 
+// shorter path to them is found later, so the result is a shortest path
+// whenever heuristic never overestimates (is admissible). 
+// result.m_settled counts expansions.
+// preconditions:	source and dest must be the numerical-order value of the
+//					vertices they represent (not the index value). 
+//					heuristic(const GraphData&, const GraphData&) returns
+//					a non-negative double.
+// postconditions:	returns the shortest path from source to dest, or a 
+//					PathResult with m_found = false if there is none
+//
+template <typename Heuristic>
+Graph::PathResult Graph::queryAStar(int source, int dest, Heuristic heuristic) const {
+	PathResult result;
+	if(source < 1 || source > m_size || dest < 1 || dest > m_size) {
+		return(result);
+	}
+	source--;
+	dest--;
+
+	shared_ptr<const CsrGraph> csr = getCsr();
+	const int *offsets = csr->getOffsets();
+	const int *adjVertices = csr->getAdjVertices();
+	const int *weights = csr->getWeights();
+	const GraphData &goal = *m_vertices[dest].m_data;
+	Scratch &scratch = threadScratch();
+	scratch.prepare(m_size);
+
+	AStarHeap heap;
+	scratch.reach(source, 0, -1);
+	heap.push(AStarEntry(heuristic(*m_vertices[source].m_data, goal), 
+		make_pair(0, source)));
+	while(!heap.empty()) {
+		int dist = heap.top().second.first;
+		int vertex = heap.top().second.second;
+		heap.pop();
+		if(dist > scratch.m_dist[vertex]) {
+			continue;
+		}
+
+		scratch.m_visited[vertex] = true;
+		result.m_settled++;
+		if(vertex == dest) {
+			break;
+		}
+
+		for(int i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+			int adj = adjVertices[i];
+			int adjDist = Traits::add(dist, weights[i]);
+			if(adjDist < scratch.m_dist[adj]) {
+				scratch.reach(adj, adjDist, vertex);
+				heap.push(AStarEntry(adjDist + 
+					heuristic(*m_vertices[adj].m_data, goal), 
+					make_pair(adjDist, adj)));
+			}
+		}
+	}
+
+	if(scratch.m_visited[dest]) {
+		extractPath(scratch, dest, result);
+	}
+	scratch.clear();
+	return(result);
+}
+
 #endif
\ No newline at end of file
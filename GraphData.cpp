@@ -3,7 +3,8 @@
 //
 // GraphData
 // a class containing a standard string representing the title of a location
-// in a weighted graph.
+// in a weighted graph. A location may optionally carry (x, y) coordinates,
+// which search heuristics use to estimate the distance between locations.
 // Contains the following overloaded operators:
 // operator==, operator!=, operator<, operator>, operator<=, operator>=,
 // and operator<<
@@ -17,7 +18,7 @@
 // preconditions:	none
 // postconditions:	creates a GraphData object with m_title equal to ""
 //
-GraphData::GraphData() : m_title("") {}
+GraphData::GraphData() : m_title(""), m_hasCoordinates(false), m_x(0), m_y(0) {}
 
 
 // constructor(string)
@@ -25,7 +26,18 @@ GraphData::GraphData() : m_title("") {}
 // preconditions:	title must be a valid std::string object
 // postconditions:	creates a GraphData object with m_title equal to title
 //
-GraphData::GraphData(string title) : m_title(title) {}
+GraphData::GraphData(string title) : m_title(title), m_hasCoordinates(false),
+	m_x(0), m_y(0) {}
+
+
+// constructor(string, double, double)
+// creates a GraphData object with m_title equal to title located at (x, y)
+// preconditions:	title must be a valid std::string object
+// postconditions:	creates a GraphData object with m_title equal to title,
+//					m_hasCoordinates = true, m_x = x, m_y = y
+//
+GraphData::GraphData(string title, double x, double y) : m_title(title), 
+	m_hasCoordinates(true), m_x(x), m_y(y) {}
 
 
 // getTitle
@@ -38,6 +50,36 @@ string GraphData::getTitle() const {
 }
 
 
+// hasCoordinates
+// returns true if this location was given coordinates, else false
+// preconditions:	none
+// postconditions:	returns m_hasCoordinates
+//
+bool GraphData::hasCoordinates() const {
+	return(m_hasCoordinates);
+}
+
+
+// getX
+// returns the x coordinate, or 0 if there are no coordinates
+// preconditions:	none
+// postconditions:	returns m_x
+//
+double GraphData::getX() const {
+	return(m_x);
+}
+
+
+// getY
+// returns the y coordinate, or 0 if there are no coordinates
+// preconditions:	none
+// postconditions:	returns m_y
+//
+double GraphData::getY() const {
+	return(m_y);
+}
+
+
 // equality
 // Compares two GraphData objects. Uses standard string equality operator.
 // Returns true if m_title and data.m_title are equal, else false.
@@ -9,7 +9,8 @@ using namespace std;
 
 // GraphData
 // a class containing a standard string representing the title of a location
-// in a weighted graph.
+// in a weighted graph. A location may optionally carry (x, y) coordinates,
+// which search heuristics use to estimate the distance between locations.
 // Contains the following overloaded operators:
 // operator==, operator!=, operator<, operator>, operator<=, operator>=,
 // and operator<<
@@ -38,6 +39,14 @@ public:
 	//
 	GraphData(string title);
 
+	// constructor(string, double, double)
+	// creates a GraphData object with m_title equal to title located at (x, y)
+	// preconditions:	title must be a valid std::string object
+	// postconditions:	creates a GraphData object with m_title equal to title,
+	//					m_hasCoordinates = true, m_x = x, m_y = y
+	//
+	GraphData(string title, double x, double y);
+
 	// getTitle
 	// returns a string equal to m_title
 	// preconditions:	none
@@ -45,6 +54,27 @@ public:
 	//
 	string getTitle() const;
 
+	// hasCoordinates
+	// returns true if this location was given coordinates, else false
+	// preconditions:	none
+	// postconditions:	returns m_hasCoordinates
+	//
+	bool hasCoordinates() const;
+
+	// getX
+	// returns the x coordinate, or 0 if there are no coordinates
+	// preconditions:	none
+	// postconditions:	returns m_x
+	//
+	double getX() const;
+
+	// getY
+	// returns the y coordinate, or 0 if there are no coordinates
+	// preconditions:	none
+	// postconditions:	returns m_y
+	//
+	double getY() const;
+
 	// equality
 	// Compares two GraphData objects. Uses standard string equality operator.
 	// Returns true if m_title and data.m_title are equal, else false.
@@ -101,6 +131,9 @@ public:
 
 private:
 	string m_title;
+	bool m_hasCoordinates;
+	double m_x;
+	double m_y;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,419 @@
+// GraphFile.cpp		Author: Sam Hoover
+// contains the definitions for the GraphFile class.
+//
+// GraphFile		Author: Sam Hoover
+//
+// Description:
+// A binary snapshot of a graph on disk, opened through a MappedFile so that
+// nothing in it is parsed or copied when it is opened. The file starts with a
+// fixed-size header giving the format version, the vertex and edge counts, 
+// and the byte position of each section. Every section starts on an 8-byte
+// boundary, so it can be read in place:
+//		-the CsrGraph offsets (size + 1 ints), adjacent vertices and weights
+//		 (edgeCount ints each)
+//		-the vertex titles, as size + 1 64-bit offsets into a block of chars
+//		-the vertex coordinates, as one flag byte and an (x, y) pair of 
+//		 doubles per vertex, present only if some vertex has coordinates
+//		-optionally, rows of a shortest path table: the source index value of
+//		 each row, then the distances and then the predecessor index values
+//		 of every row, size ints per row. A distance of INFINITY (INT_MAX)
+//		 means no path, and its predecessor is -1.
+//
+// Functionality:
+// write(...) saves a graph's CsrGraph, GraphData and table rows to a file.
+// Opening a GraphFile maps the file and checks its header; isOpen() is false
+// if the file is missing, was written by a different format version or byte
+// order, or is truncated. getCsr() then returns a CsrGraph that reads the 
+// mapped arrays in place and keeps the mapping alive on its own, so a Graph
+// can keep using it after the GraphFile is gone. Processes that open the 
+// same file share one page-cached copy of it.
+//
+// Assumptions:
+// This class assumes the following:
+//		-files are written by write(...) and not modified afterwards. Opening
+//		 checks that every section fits and every index is in range, not that
+//		 the distances are the shortest ones
+//
+#ifndef GRAPHFILE_CPP
+#define GRAPHFILE_CPP
+#include "GraphFile.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+
+// identifies a GraphFile; m_byteOrder catches files from other byte orders
+static const char MAGIC[8] = { 'H', 'W', '3', 'G', 'R', 'A', 'P', 'H' };
+static const uint32_t ORDER_CHECK = 0x01020304;
+
+const uint32_t GraphFile::VERSION;
+
+
+// constructor(string)
+// maps fileName and checks its header
+// preconditions:	none
+// postconditions:	isOpen() is true if fileName holds a valid snapshot 
+//					of this VERSION
+//
+GraphFile::GraphFile(const string &fileName) : 
+	m_file(make_shared<MappedFile>(fileName)), m_header(nullptr) {
+	if(m_file->isOpen() && m_file->getSize() >= sizeof(Header)) {
+		m_header = reinterpret_cast<const Header*>(m_file->getData());
+		if(!isValid()) {
+			m_header = nullptr;
+		}
+	}
+}
+
+
+// isValid: constructor helper
+// checks the header and section positions of the mapped file, and that
+// every adjacent vertex, weight and table row holds values the engines and
+// path walks can use without reading out of bounds. The checks read each
+// edge once and each table entry at most twice.
+// preconditions:	m_file is open
+// postconditions:	returns true if the file can be read safely
+//
+bool GraphFile::isValid() const {
+	const Header &header = *m_header;
+	if(memcmp(header.m_magic, MAGIC, sizeof(MAGIC)) != 0 ||
+		header.m_version != VERSION || header.m_byteOrder != ORDER_CHECK ||
+		header.m_size < 0 || header.m_edgeCount < 0 || header.m_rowCount < 0) {
+		return(false);
+	}
+	for(int i = 0; i < SECTION_COUNT; i++) {
+		Section section = static_cast<Section>(i);
+		uint64_t start = header.m_sections[i];
+		bool optional = (section == COORDINATE_FLAGS || section == COORDINATES ||
+			(section >= ROW_SOURCES && header.m_rowCount == 0));
+		if(start == 0) {
+			if(!optional) {
+				return(false);
+			}
+			continue;
+		}
+		// compared without adding, since a damaged start could wrap the sum
+		uint64_t fileSize = m_file->getSize();
+		if(start % 8 != 0 || start < sizeof(Header) || start > fileSize ||
+			sectionLength(header, section) > fileSize - start) {
+			return(false);
+		}
+	}
+	if((header.m_sections[COORDINATE_FLAGS] == 0) != 
+		(header.m_sections[COORDINATES] == 0)) {
+		return(false);
+	}
+
+	// the offsets must be usable as array bounds
+	const int32_t *offsets = at<int32_t>(OFFSETS);
+	const uint64_t *titleOffsets = at<uint64_t>(TITLE_OFFSETS);
+	if(offsets[0] != 0 || titleOffsets[0] != 0) {
+		return(false);
+	}
+	for(int i = 0; i < header.m_size; i++) {
+		if(offsets[i + 1] < offsets[i] || titleOffsets[i + 1] < titleOffsets[i]) {
+			return(false);
+		}
+	}
+	if(offsets[header.m_size] != header.m_edgeCount || 
+		titleOffsets[header.m_size] != header.m_titleBytes) {
+		return(false);
+	}
+	const int32_t *adjVertices = at<int32_t>(ADJ_VERTICES);
+	const int32_t *weights = at<int32_t>(WEIGHTS);
+	for(int i = 0; i < header.m_edgeCount; i++) {
+		if(adjVertices[i] < 0 || adjVertices[i] >= header.m_size || 
+			weights[i] < 0) {
+			return(false);
+		}
+	}
+	for(int row = 0; row < header.m_rowCount; row++) {
+		int source = at<int32_t>(ROW_SOURCES)[row];
+		if(source < 0 || source >= header.m_size) {
+			return(false);
+		}
+	}
+	vector<char> state(header.m_size);
+	for(int row = 0; row < header.m_rowCount; row++) {
+		if(!isValidRow(row, state)) {
+			return(false);
+		}
+	}
+	return(true);
+}
+
+
+// isValidRow: constructor helper
+// checks that row's distances and predecessors form a shortest path tree
+// from its source: the source has distance 0 and is its own predecessor,
+// and the predecessors of every other reached vertex are reached vertices
+// that lead back to the source without a cycle
+// preconditions:	isValid() has checked the sections and row sources;
+//					state holds getSize() entries
+// postconditions:	returns true if the row is valid; state is changed
+//
+bool GraphFile::isValidRow(int row, vector<char> &state) const {
+	enum { UNCHECKED, ON_WALK, LEADS_TO_SOURCE };
+	int size = m_header->m_size;
+	int source = getRowSource(row);
+	const int *dist = getRowDist(row);
+	const int *pred = getRowPred(row);
+	if(dist[source] != 0 || pred[source] != source) {
+		return(false);
+	}
+	fill(state.begin(), state.end(), static_cast<char>(UNCHECKED));
+	state[source] = LEADS_TO_SOURCE;
+	for(int i = 0; i < size; i++) {
+		if(dist[i] == INT_MAX) {
+			continue;
+		}
+		if(dist[i] < 0) {
+			return(false);
+		}
+
+		// walk back until a vertex already known to lead to the source
+		int vertex = i;
+		while(state[vertex] == UNCHECKED) {
+			state[vertex] = ON_WALK;
+			vertex = pred[vertex];
+			if(vertex < 0 || vertex >= size || dist[vertex] == INT_MAX) {
+				return(false);
+			}
+		}
+		if(state[vertex] == ON_WALK) {
+			return(false);
+		}
+		for(vertex = i; state[vertex] == ON_WALK; vertex = pred[vertex]) {
+			state[vertex] = LEADS_TO_SOURCE;
+		}
+	}
+	return(true);
+}
+
+
+// sectionLength
+// returns the number of bytes in section for the given header
+// preconditions:	none
+// postconditions:	returns the length of section, without padding
+//
+uint64_t GraphFile::sectionLength(const Header &header, Section section) {
+	uint64_t size = static_cast<uint64_t>(header.m_size);
+	uint64_t edges = static_cast<uint64_t>(header.m_edgeCount);
+	uint64_t rows = static_cast<uint64_t>(header.m_rowCount);
+	switch(section) {
+	case OFFSETS:			return((size + 1) * sizeof(int32_t));
+	case ADJ_VERTICES:		return(edges * sizeof(int32_t));
+	case WEIGHTS:			return(edges * sizeof(int32_t));
+	case TITLE_OFFSETS:		return((size + 1) * sizeof(uint64_t));
+	case TITLES:			return(header.m_titleBytes);
+	case COORDINATE_FLAGS:	return(size);
+	case COORDINATES:		return(size * 2 * sizeof(double));
+	case ROW_SOURCES:		return(rows * sizeof(int32_t));
+	case ROW_DIST:			return(rows * size * sizeof(int32_t));
+	case ROW_PRED:			return(rows * size * sizeof(int32_t));
+	default:				return(0);
+	}
+}
+
+
+// at
+// returns a pointer to the start of section in the mapped file
+// preconditions:	isOpen() is true and section is present
+// postconditions:	returns m_file->getData() + m_sections[section]
+//
+template <typename T>
+const T *GraphFile::at(Section section) const {
+	return(reinterpret_cast<const T*>(m_file->getData() + 
+		m_header->m_sections[section]));
+}
+
+
+// isOpen
+// returns true if the file was opened and its header is valid
+// preconditions:	none
+// postconditions:	returns true if m_header is not nullptr
+//
+bool GraphFile::isOpen() const {
+	return(m_header != nullptr);
+}
+
+
+// getSize
+// returns the number of vertices
+// preconditions:	isOpen() is true
+// postconditions:	returns the vertex count from the header
+//
+int GraphFile::getSize() const {
+	return(m_header->m_size);
+}
+
+
+// getEdgeCount
+// returns the number of edges
+// preconditions:	isOpen() is true
+// postconditions:	returns the edge count from the header
+//
+int GraphFile::getEdgeCount() const {
+	return(m_header->m_edgeCount);
+}
+
+
+// getCsr
+// returns the edges as a CsrGraph reading the mapped file in place
+// preconditions:	isOpen() is true
+// postconditions:	returns a CsrGraph that keeps the mapping alive
+//
+shared_ptr<const CsrGraph> GraphFile::getCsr() const {
+	return(make_shared<const CsrGraph>(m_header->m_size, m_header->m_edgeCount,
+		at<int32_t>(OFFSETS), at<int32_t>(ADJ_VERTICES), at<int32_t>(WEIGHTS),
+		m_file));
+}
+
+
+// getData
+// returns the title and coordinates of vertex as a GraphData
+// preconditions:	isOpen() is true; vertex must be an index value
+// postconditions:	returns the GraphData that was written for vertex
+//
+GraphData GraphFile::getData(int vertex) const {
+	const uint64_t *titleOffsets = at<uint64_t>(TITLE_OFFSETS);
+	string title(at<char>(TITLES) + titleOffsets[vertex], 
+		titleOffsets[vertex + 1] - titleOffsets[vertex]);
+	if(m_header->m_sections[COORDINATE_FLAGS] != 0 && 
+		at<char>(COORDINATE_FLAGS)[vertex] != 0) {
+		const double *coordinates = at<double>(COORDINATES) + 2 * vertex;
+		return(GraphData(title, coordinates[0], coordinates[1]));
+	}
+	return(GraphData(title));
+}
+
+
+// getRowCount
+// returns the number of shortest path table rows in the file
+// preconditions:	isOpen() is true
+// postconditions:	returns the row count from the header
+//
+int GraphFile::getRowCount() const {
+	return(m_header->m_rowCount);
+}
+
+
+// getRowSource
+// returns the source index value of row
+// preconditions:	isOpen() is true; 0 <= row < getRowCount()
+// postconditions:	returns the source the row was computed from
+//
+int GraphFile::getRowSource(int row) const {
+	return(at<int32_t>(ROW_SOURCES)[row]);
+}
+
+
+// getRowDist
+// returns the distances of row, holding getSize() entries
+// preconditions:	isOpen() is true; 0 <= row < getRowCount()
+// postconditions:	returns a pointer into the mapped file
+//
+const int *GraphFile::getRowDist(int row) const {
+	return(at<int32_t>(ROW_DIST) + static_cast<size_t>(row) * m_header->m_size);
+}
+
+
+// getRowPred
+// returns the predecessors of row, holding getSize() entries
+// preconditions:	isOpen() is true; 0 <= row < getRowCount()
+// postconditions:	returns a pointer into the mapped file
+//
+const int *GraphFile::getRowPred(int row) const {
+	return(at<int32_t>(ROW_PRED) + static_cast<size_t>(row) * m_header->m_size);
+}
+
+
+// write
+// saves csr, data and the given table rows to fileName. rowDist and 
+// rowPred hold csr.getSize() entries for each source in rowSources, in 
+// the same order. The file is written under a temporary name in the same
+// directory and then renamed to fileName, so a mapping of the old fileName,
+// which csr may be reading from, keeps the old contents.
+// preconditions:	data holds csr.getSize() valid GraphData pointers
+// postconditions:	returns true if fileName was written completely; 
+//					otherwise fileName is unchanged
+//
+bool GraphFile::write(const string &fileName, const CsrGraph &csr, 
+	const vector<const GraphData*> &data, const vector<int> &rowSources,
+	const vector<int> &rowDist, const vector<int> &rowPred) {
+	int size = csr.getSize();
+	string titles;
+	vector<uint64_t> titleOffsets(1, 0);
+	vector<char> coordinateFlags(size, 0);
+	vector<double> coordinates(2 * size, 0.0);
+	bool anyCoordinates = false;
+	for(int i = 0; i < size; i++) {
+		titles += data[i]->getTitle();
+		titleOffsets.push_back(titles.size());
+		if(data[i]->hasCoordinates()) {
+			anyCoordinates = true;
+			coordinateFlags[i] = 1;
+			coordinates[2 * i] = data[i]->getX();
+			coordinates[2 * i + 1] = data[i]->getY();
+		}
+	}
+
+	Header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.m_magic, MAGIC, sizeof(MAGIC));
+	header.m_version = VERSION;
+	header.m_byteOrder = ORDER_CHECK;
+	header.m_size = size;
+	header.m_edgeCount = csr.getEdgeCount();
+	header.m_rowCount = static_cast<int32_t>(rowSources.size());
+	header.m_titleBytes = titles.size();
+
+	// the contents of each section, and whether it is written at all
+	const void *contents[SECTION_COUNT] = { csr.getOffsets(), 
+		csr.getAdjVertices(), csr.getWeights(), titleOffsets.data(), 
+		titles.data(), coordinateFlags.data(), coordinates.data(), 
+		rowSources.data(), rowDist.data(), rowPred.data() };
+	bool present[SECTION_COUNT] = { true, true, true, true, true, 
+		anyCoordinates, anyCoordinates, !rowSources.empty(), 
+		!rowSources.empty(), !rowSources.empty() };
+	uint64_t position = sizeof(Header);
+	for(int i = 0; i < SECTION_COUNT; i++) {
+		if(present[i]) {
+			position = (position + 7) / 8 * 8;
+			header.m_sections[i] = position;
+			position += sectionLength(header, static_cast<Section>(i));
+		}
+	}
+
+	// opening fileName itself with "wb" would truncate a file that is mapped,
+	// by this process or another, and reading it would then fault
+	string tempName = fileName + ".tmp";
+	FILE *file = fopen(tempName.c_str(), "wb");
+	if(file == nullptr) {
+		return(false);
+	}
+	bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+	position = sizeof(Header);
+	static const char padding[8] = { 0 };
+	for(int i = 0; i < SECTION_COUNT && written; i++) {
+		if(!present[i]) {
+			continue;
+		}
+		uint64_t length = sectionLength(header, static_cast<Section>(i));
+		size_t pad = static_cast<size_t>(header.m_sections[i] - position);
+		written = fwrite(padding, 1, pad, file) == pad && (length == 0 ||
+			fwrite(contents[i], 1, length, file) == length);
+		position = header.m_sections[i] + length;
+	}
+	written = (fflush(file) == 0) && written;
+	written = (fclose(file) == 0) && written;
+	if(written) {
+		written = (rename(tempName.c_str(), fileName.c_str()) == 0);
+	}
+	if(!written) {
+		remove(tempName.c_str());
+	}
+	return(written);
+}
+
+#endif
\ No newline at end of file
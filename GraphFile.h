@@ -0,0 +1,201 @@
+// GraphFile.h		Author: Sam Hoover
+// contains the declarations for the GraphFile class.
+//
+#ifndef GRAPHFILE_H
+#define GRAPHFILE_H
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "MappedFile.h"
+#include "CsrGraph.h"
+#include "GraphData.h"
+using namespace std;
+
+// GraphFile		Author: Sam Hoover
+//
+// Description:
+// A binary snapshot of a graph on disk, opened through a MappedFile so that
+// nothing in it is parsed or copied when it is opened. The file starts with a
+// fixed-size header giving the format version, the vertex and edge counts, 
+// and the byte position of each section. Every section starts on an 8-byte
+// boundary, so it can be read in place:
+//		-the CsrGraph offsets (size + 1 ints), adjacent vertices and weights
+//		 (edgeCount ints each)
+//		-the vertex titles, as size + 1 64-bit offsets into a block of chars
+//		-the vertex coordinates, as one flag byte and an (x, y) pair of 
+//		 doubles per vertex, present only if some vertex has coordinates
+//		-optionally, rows of a shortest path table: the source index value of
+//		 each row, then the distances and then the predecessor index values
+//		 of every row, size ints per row. A distance of INFINITY (INT_MAX)
+//		 means no path, and its predecessor is -1.
+//
+// Functionality:
+// write(...) saves a graph's CsrGraph, GraphData and table rows to a file.
+// Opening a GraphFile maps the file and checks its header; isOpen() is false
+// if the file is missing, was written by a different format version or byte
+// order, or is truncated. getCsr() then returns a CsrGraph that reads the 
+// mapped arrays in place and keeps the mapping alive on its own, so a Graph
+// can keep using it after the GraphFile is gone. Processes that open the 
+// same file share one page-cached copy of it.
+//
+// Assumptions:
+// This class assumes the following:
+//		-files are written by write(...) and not modified afterwards. Opening
+//		 checks that every section fits and every index is in range, not that
+//		 the distances are the shortest ones
+//
+class GraphFile {
+public:
+	static const uint32_t VERSION = 2;
+
+	// constructor(string)
+	// maps fileName and checks its header
+	// preconditions:	none
+	// postconditions:	isOpen() is true if fileName holds a valid snapshot 
+	//					of this VERSION
+	//
+	explicit GraphFile(const string &fileName);
+
+	// isOpen
+	// returns true if the file was opened and its header is valid
+	// preconditions:	none
+	// postconditions:	returns true if m_header is not nullptr
+	//
+	bool isOpen() const;
+
+	// getSize
+	// returns the number of vertices
+	// preconditions:	isOpen() is true
+	// postconditions:	returns the vertex count from the header
+	//
+	int getSize() const;
+
+	// getEdgeCount
+	// returns the number of edges
+	// preconditions:	isOpen() is true
+	// postconditions:	returns the edge count from the header
+	//
+	int getEdgeCount() const;
+
+	// getCsr
+	// returns the edges as a CsrGraph reading the mapped file in place
+	// preconditions:	isOpen() is true
+	// postconditions:	returns a CsrGraph that keeps the mapping alive
+	//
+	shared_ptr<const CsrGraph> getCsr() const;
+
+	// getData
+	// returns the title and coordinates of vertex as a GraphData
+	// preconditions:	isOpen() is true; vertex must be an index value
+	// postconditions:	returns the GraphData that was written for vertex
+	//
+	GraphData getData(int vertex) const;
+
+	// getRowCount
+	// returns the number of shortest path table rows in the file
+	// preconditions:	isOpen() is true
+	// postconditions:	returns the row count from the header
+	//
+	int getRowCount() const;
+
+	// getRowSource
+	// returns the source index value of row
+	// preconditions:	isOpen() is true; 0 <= row < getRowCount()
+	// postconditions:	returns the source the row was computed from
+	//
+	int getRowSource(int row) const;
+
+	// getRowDist
+	// returns the distances of row, holding getSize() entries
+	// preconditions:	isOpen() is true; 0 <= row < getRowCount()
+	// postconditions:	returns a pointer into the mapped file
+	//
+	const int *getRowDist(int row) const;
+
+	// getRowPred
+	// returns the predecessors of row, holding getSize() entries
+	// preconditions:	isOpen() is true; 0 <= row < getRowCount()
+	// postconditions:	returns a pointer into the mapped file
+	//
+	const int *getRowPred(int row) const;
+
+	// write
+	// saves csr, data and the given table rows to fileName. rowDist and 
+	// rowPred hold csr.getSize() entries for each source in rowSources, in 
+	// the same order. The file is written under a temporary name in the same
+	// directory and then renamed to fileName, so a mapping of the old fileName,
+	// which csr may be reading from, keeps the old contents.
+	// preconditions:	data holds csr.getSize() valid GraphData pointers
+	// postconditions:	returns true if fileName was written completely; 
+	//					otherwise fileName is unchanged
+	//
+	static bool write(const string &fileName, const CsrGraph &csr, 
+		const vector<const GraphData*> &data, const vector<int> &rowSources,
+		const vector<int> &rowDist, const vector<int> &rowPred);
+
+private:
+	// Section
+	// the sections of the file, in the order they are written
+	//
+	enum Section { OFFSETS, ADJ_VERTICES, WEIGHTS, TITLE_OFFSETS, TITLES,
+		COORDINATE_FLAGS, COORDINATES, ROW_SOURCES, ROW_DIST, ROW_PRED,
+		SECTION_COUNT };
+
+	// Header
+	// the fixed-size start of the file. m_sections holds the byte position 
+	// of each Section, or 0 for an absent section.
+	//
+	struct Header {
+		char m_magic[8];
+		uint32_t m_version;
+		uint32_t m_byteOrder;
+		int32_t m_size;
+		int32_t m_edgeCount;
+		int32_t m_rowCount;
+		int32_t m_reserved;
+		uint64_t m_titleBytes;
+		uint64_t m_sections[SECTION_COUNT];
+	};
+
+	shared_ptr<MappedFile> m_file;
+	const Header *m_header;		// nullptr if the file is not valid
+
+	// sectionLength
+	// returns the number of bytes in section for the given header
+	// preconditions:	none
+	// postconditions:	returns the length of section, without padding
+	//
+	static uint64_t sectionLength(const Header &header, Section section);
+
+	// at
+	// returns a pointer to the start of section in the mapped file
+	// preconditions:	isOpen() is true and section is present
+	// postconditions:	returns m_file->getData() + m_sections[section]
+	//
+	template <typename T>
+	const T *at(Section section) const;
+
+	// isValid: constructor helper
+	// checks the header and section positions of the mapped file, and that
+	// every adjacent vertex, weight and table row holds values the engines and
+	// path walks can use without reading out of bounds. The checks read each
+	// edge once and each table entry at most twice.
+	// preconditions:	m_file is open
+	// postconditions:	returns true if the file can be read safely
+	//
+	bool isValid() const;
+
+	// isValidRow: constructor helper
+	// checks that row's distances and predecessors form a shortest path tree
+	// from its source: the source has distance 0 and is its own predecessor,
+	// and the predecessors of every other reached vertex are reached vertices
+	// that lead back to the source without a cycle
+	// preconditions:	isValid() has checked the sections and row sources;
+	//					state holds getSize() entries
+	// postconditions:	returns true if the row is valid; state is changed
+	//
+	bool isValidRow(int row, vector<char> &state) const;
+};
+
+#endif
\ No newline at end of file
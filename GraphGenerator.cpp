@@ -0,0 +1,304 @@
+// GraphGenerator.cpp		Author: Sam Hoover
+// contains the definitions for the GraphGenerator class.
+//
+// GraphGenerator		Author: Sam Hoover
+//
+// Description:
+// Builds reproducible synthetic graphs for benchmarking the Graph 
+// shortest-path engines. A GraphGenerator is given a shape, a number of 
+// vertices, a target number of edges, the heaviest edge weight and a seed,
+// and produces the vertex titles and (source, dest, cost) triples of a 
+// graph, as numerical-order values, for Graph::buildGraph(vector<string>, 
+// const EdgeTriple*, int), or writes them as a file in the format outlined
+// in HW3.pdf for Graph::buildGraph(ifstream&).
+//
+// Functionality:
+// RANDOM_SPARSE draws each edge's source and dest uniformly. GRID lays the
+// vertices out row by row on a square grid, like a road network, joins each
+// to its neighbors in both directions and then adds short local links 
+// until the edge count is reached; its titles carry "@ x y" coordinates, and
+// no edge is lighter than the straight-line distance it covers, so the A* 
+// heuristics stay admissible. SCALE_FREE grows the graph by preferential 
+// attachment, so a few hub vertices gain very high degree. DENSE keeps each
+// ordered pair of vertices as an edge with the probability that gives the 
+// edge count, and is meant for a few thousand vertices at most. Weights are
+// drawn uniformly from 1 through m_maxWeight. 
+//
+// The random numbers come from a SplitMix64 generator of the generator's
+// own rather than from <random>, whose distributions differ between 
+// standard libraries, so a seed gives the same graph everywhere. Every call
+// to generate(...) or generatePairs(int) starts again from the seed.
+// Repeated (source, dest) pairs may be generated; Graph keeps the last one.
+//
+// Assumptions:
+// This class assumes the following:
+//		-size >= 1, edgeCount >= 0 and maxWeight >= 1
+//
+#ifndef GRAPHGENERATOR_CPP
+#define GRAPHGENERATOR_CPP
+#include "GraphGenerator.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+// constructor(Shape, int, int, int, unsigned long long)
+// creates a GraphGenerator for graphs of the given shape with size 
+// vertices and about edgeCount edges no heavier than maxWeight
+// preconditions:	the class assumptions hold
+// postconditions:	m_shape = shape; m_size = size; m_edgeCount = edgeCount;
+//					m_maxWeight = maxWeight; m_seed = seed
+//
+GraphGenerator::GraphGenerator(Shape shape, int size, int edgeCount, int maxWeight,
+	unsigned long long seed) : m_shape(shape), m_size(size),
+	m_edgeCount(edgeCount), m_maxWeight(maxWeight), m_seed(seed), m_state(seed) {}
+
+
+// generate
+// sets titles and edges to the vertex titles and edges of the graph
+// preconditions:	none
+// postconditions:	titles holds m_size titles; edges holds the generated
+//					triples, as numerical-order values
+//
+void GraphGenerator::generate(vector<string> &titles, 
+	vector<Graph::EdgeTriple> &edges) {
+	m_state = m_seed;
+	titles.assign(m_size, "");
+	for(int i = 0; i < m_size; i++) {
+		titles[i] = "v" + to_string(i + 1);
+	}
+	edges.clear();
+	if(m_size < 2) {
+		return;
+	}
+
+	if(m_shape == GRID) {
+		generateGrid(titles, edges);
+	} else if(m_shape == SCALE_FREE) {
+		generateScaleFree(edges);
+	} else if(m_shape == DENSE) {
+		generateDense(edges);
+	} else {
+		generateSparse(edges);
+	}
+}
+
+
+// generatePairs
+// returns count (source, dest) pairs of vertices drawn uniformly, as 
+// numerical-order values, for timing single-pair queries
+// preconditions:	none
+// postconditions:	returns count pairs
+//
+vector<pair<int, int> > GraphGenerator::generatePairs(int count) {
+	m_state = m_seed;
+	vector<pair<int, int> > pairs(count);
+	for(int i = 0; i < count; i++) {
+		pairs[i].first = nextInt(m_size) + 1;
+		pairs[i].second = nextInt(m_size) + 1;
+	}
+	return(pairs);
+}
+
+
+// writeFile
+// writes titles and edges to fileName in the format outlined in HW3.pdf
+// preconditions:	no title holds a line break
+// postconditions:	returns true if fileName was written completely
+//
+bool GraphGenerator::writeFile(const string &fileName, 
+	const vector<string> &titles, const vector<Graph::EdgeTriple> &edges) {
+	ofstream outFile(fileName.c_str());
+	outFile << titles.size() << '\n';
+	for(size_t i = 0; i < titles.size(); i++) {
+		outFile << titles[i] << '\n';
+	}
+	for(size_t i = 0; i < edges.size(); i++) {
+		outFile << edges[i].m_source << ' ' << edges[i].m_dest << ' ' 
+			<< edges[i].m_cost << '\n';
+	}
+	outFile << "0 0 0" << endl;
+	return(outFile.good());
+}
+
+
+// parseShape
+// sets shape to the shape named name, as returned by shapeName(Shape)
+// preconditions:	none
+// postconditions:	returns true and sets shape if name is a shape's name,
+//					else returns false
+//
+bool GraphGenerator::parseShape(const string &name, Shape &shape) {
+	const Shape shapes[] = { RANDOM_SPARSE, GRID, SCALE_FREE, DENSE };
+	for(int i = 0; i < 4; i++) {
+		if(name == shapeName(shapes[i])) {
+			shape = shapes[i];
+			return(true);
+		}
+	}
+	return(false);
+}
+
+
+// shapeName
+// returns the name of shape: "sparse", "grid", "scalefree" or "dense"
+// preconditions:	none
+// postconditions:	returns the name
+//
+string GraphGenerator::shapeName(Shape shape) {
+	switch(shape) {
+		case GRID:
+			return("grid");
+		case SCALE_FREE:
+			return("scalefree");
+		case DENSE:
+			return("dense");
+		default:
+			return("sparse");
+	}
+}
+
+
+// generateSparse: generate helper
+// appends m_edgeCount edges between uniformly drawn vertices
+// preconditions:	none
+// postconditions:	edges holds the RANDOM_SPARSE edges
+//
+void GraphGenerator::generateSparse(vector<Graph::EdgeTriple> &edges) {
+	edges.reserve(m_edgeCount);
+	for(int i = 0; i < m_edgeCount; i++) {
+		int source = nextInt(m_size);
+		int dest = nextInt(m_size - 1);
+		addEdge(edges, source, (dest >= source) ? dest + 1 : dest);
+	}
+}
+
+
+// generateGrid: generate helper
+// names the vertices by their grid position and appends the grid edges,
+// then local links until there are m_edgeCount edges
+// preconditions:	titles holds m_size entries
+// postconditions:	titles and edges hold the GRID graph
+//
+void GraphGenerator::generateGrid(vector<string> &titles, 
+	vector<Graph::EdgeTriple> &edges) {
+	int width = 1;
+	while(width * width < m_size) {
+		width++;
+	}
+	for(int i = 0; i < m_size; i++) {
+		titles[i] = "r" + to_string(i / width) + "c" + to_string(i % width) + 
+			" @ " + to_string(i % width) + " " + to_string(i / width);
+	}
+
+	for(int i = 0; i < m_size; i++) {
+		if(i % width + 1 < width && i + 1 < m_size) {
+			addEdge(edges, i, i + 1);
+			addEdge(edges, i + 1, i);
+		}
+		if(i + width < m_size) {
+			addEdge(edges, i, i + width);
+			addEdge(edges, i + width, i);
+		}
+	}
+
+	// local links reach up to 2 rows and columns away, and are at least as
+	// heavy as their grid (Manhattan) length
+	while(static_cast<int>(edges.size()) < m_edgeCount) {
+		int source = nextInt(m_size);
+		int column = source % width + nextInt(5) - 2;
+		int row = source / width + nextInt(5) - 2;
+		int dest = row * width + column;
+		if(column >= 0 && column < width && row >= 0 && dest < m_size && 
+			dest != source) {
+			int length = abs(column - source % width) + abs(row - source / width);
+			addEdge(edges, source, dest, length);
+		}
+	}
+}
+
+
+// generateScaleFree: generate helper
+// adds the vertices one at a time, linking each both ways to earlier 
+// vertices chosen with probability proportional to their degree
+// preconditions:	none
+// postconditions:	edges holds the SCALE_FREE edges
+//
+void GraphGenerator::generateScaleFree(vector<Graph::EdgeTriple> &edges) {
+	// every edge adds both its ends to ends, so a vertex is drawn from ends
+	// with probability proportional to its degree
+	int links = max(1, m_edgeCount / (2 * m_size));
+	vector<int> ends;
+	ends.push_back(0);
+	for(int vertex = 1; vertex < m_size; vertex++) {
+		int count = min(links, vertex);
+		for(int i = 0; i < count; i++) {
+			int target = ends[nextInt(static_cast<int>(ends.size()))];
+			addEdge(edges, vertex, target);
+			addEdge(edges, target, vertex);
+			ends.push_back(target);
+			ends.push_back(vertex);
+		}
+	}
+}
+
+
+// generateDense: generate helper
+// keeps each ordered pair of distinct vertices as an edge with probability
+// m_edgeCount / (m_size * (m_size - 1))
+// preconditions:	none
+// postconditions:	edges holds the DENSE edges
+//
+void GraphGenerator::generateDense(vector<Graph::EdgeTriple> &edges) {
+	// keep a pair when a 30-bit draw is below threshold
+	long long pairs = static_cast<long long>(m_size) * (m_size - 1);
+	long long threshold = min(pairs, static_cast<long long>(m_edgeCount)) * 
+		(1LL << 30) / pairs;
+	for(int source = 0; source < m_size; source++) {
+		for(int dest = 0; dest < m_size; dest++) {
+			if(dest != source && nextInt(1 << 30) < threshold) {
+				addEdge(edges, source, dest);
+			}
+		}
+	}
+}
+
+
+// addEdge
+// appends the edge from index value source to index value dest with a 
+// weight of at least minWeight times a uniformly drawn weight
+// preconditions:	minWeight >= 1
+// postconditions:	edges holds one more triple
+//
+void GraphGenerator::addEdge(vector<Graph::EdgeTriple> &edges, int source, 
+	int dest, int minWeight) {
+	Graph::EdgeTriple edge;
+	edge.m_source = source + 1;
+	edge.m_dest = dest + 1;
+	edge.m_cost = minWeight * (nextInt(m_maxWeight) + 1);
+	edges.push_back(edge);
+}
+
+
+// nextRandom
+// advances m_state and returns the next 64 random bits (SplitMix64)
+// preconditions:	none
+// postconditions:	m_state is advanced; returns the bits
+//
+unsigned long long GraphGenerator::nextRandom() {
+	unsigned long long bits = (m_state += 0x9E3779B97F4A7C15ULL);
+	bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBULL;
+	return(bits ^ (bits >> 31));
+}
+
+
+// nextInt
+// returns an integer drawn uniformly from 0 through bound - 1
+// preconditions:	bound >= 1
+// postconditions:	returns the integer
+//
+int GraphGenerator::nextInt(int bound) {
+	return(static_cast<int>(((nextRandom() >> 32) * static_cast<unsigned long long>(bound)) >> 32));
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,164 @@
+// GraphGenerator.h		Author: Sam Hoover
+// contains the declarations for the GraphGenerator class.
+//
+#ifndef GRAPHGENERATOR_H
+#define GRAPHGENERATOR_H
+#include <string>
+#include <utility>
+#include <vector>
+#include "Graph.h"
+using namespace std;
+
+// GraphGenerator		Author: Sam Hoover
+//
+// Description:
+// Builds reproducible synthetic graphs for benchmarking the Graph 
+// shortest-path engines. A GraphGenerator is given a shape, a number of 
+// vertices, a target number of edges, the heaviest edge weight and a seed,
+// and produces the vertex titles and (source, dest, cost) triples of a 
+// graph, as numerical-order values, for Graph::buildGraph(vector<string>, 
+// const EdgeTriple*, int), or writes them as a file in the format outlined
+// in HW3.pdf for Graph::buildGraph(ifstream&).
+//
+// Functionality:
+// RANDOM_SPARSE draws each edge's source and dest uniformly. GRID lays the
+// vertices out row by row on a square grid, like a road network, joins each
+// to its neighbors in both directions and then adds short local links 
+// until the edge count is reached; its titles carry "@ x y" coordinates, and
+// no edge is lighter than the straight-line distance it covers, so the A* 
+// heuristics stay admissible. SCALE_FREE grows the graph by preferential 
+// attachment, so a few hub vertices gain very high degree. DENSE keeps each
+// ordered pair of vertices as an edge with the probability that gives the 
+// edge count, and is meant for a few thousand vertices at most. Weights are
+// drawn uniformly from 1 through m_maxWeight. 
+//
+// The random numbers come from a SplitMix64 generator of the generator's
+// own rather than from <random>, whose distributions differ between 
+// standard libraries, so a seed gives the same graph everywhere. Every call
+// to generate(...) or generatePairs(int) starts again from the seed.
+// Repeated (source, dest) pairs may be generated; Graph keeps the last one.
+//
+// Assumptions:
+// This class assumes the following:
+//		-size >= 1, edgeCount >= 0 and maxWeight >= 1
+//
+class GraphGenerator {
+public:
+	// Shape
+	// the kind of graph generate(...) builds, described above
+	//
+	enum Shape { RANDOM_SPARSE, GRID, SCALE_FREE, DENSE };
+
+	// constructor(Shape, int, int, int, unsigned long long)
+	// creates a GraphGenerator for graphs of the given shape with size 
+	// vertices and about edgeCount edges no heavier than maxWeight
+	// preconditions:	the class assumptions hold
+	// postconditions:	m_shape = shape; m_size = size; m_edgeCount = edgeCount;
+	//					m_maxWeight = maxWeight; m_seed = seed
+	//
+	GraphGenerator(Shape shape, int size, int edgeCount, int maxWeight = 100,
+		unsigned long long seed = 1);
+
+	// generate
+	// sets titles and edges to the vertex titles and edges of the graph
+	// preconditions:	none
+	// postconditions:	titles holds m_size titles; edges holds the generated
+	//					triples, as numerical-order values
+	//
+	void generate(vector<string> &titles, vector<Graph::EdgeTriple> &edges);
+
+	// generatePairs
+	// returns count (source, dest) pairs of vertices drawn uniformly, as 
+	// numerical-order values, for timing single-pair queries
+	// preconditions:	none
+	// postconditions:	returns count pairs
+	//
+	vector<pair<int, int> > generatePairs(int count);
+
+	// writeFile
+	// writes titles and edges to fileName in the format outlined in HW3.pdf
+	// preconditions:	no title holds a line break
+	// postconditions:	returns true if fileName was written completely
+	//
+	static bool writeFile(const string &fileName, const vector<string> &titles,
+		const vector<Graph::EdgeTriple> &edges);
+
+	// parseShape
+	// sets shape to the shape named name, as returned by shapeName(Shape)
+	// preconditions:	none
+	// postconditions:	returns true and sets shape if name is a shape's name,
+	//					else returns false
+	//
+	static bool parseShape(const string &name, Shape &shape);
+
+	// shapeName
+	// returns the name of shape: "sparse", "grid", "scalefree" or "dense"
+	// preconditions:	none
+	// postconditions:	returns the name
+	//
+	static string shapeName(Shape shape);
+
+private:
+	Shape m_shape;
+	int m_size;
+	int m_edgeCount;
+	int m_maxWeight;
+	unsigned long long m_seed;
+	unsigned long long m_state;		// SplitMix64 state, reset to m_seed
+
+	// generateSparse: generate helper
+	// appends m_edgeCount edges between uniformly drawn vertices
+	// preconditions:	none
+	// postconditions:	edges holds the RANDOM_SPARSE edges
+	//
+	void generateSparse(vector<Graph::EdgeTriple> &edges);
+
+	// generateGrid: generate helper
+	// names the vertices by their grid position and appends the grid edges,
+	// then local links until there are m_edgeCount edges
+	// preconditions:	titles holds m_size entries
+	// postconditions:	titles and edges hold the GRID graph
+	//
+	void generateGrid(vector<string> &titles, vector<Graph::EdgeTriple> &edges);
+
+	// generateScaleFree: generate helper
+	// adds the vertices one at a time, linking each both ways to earlier 
+	// vertices chosen with probability proportional to their degree
+	// preconditions:	none
+	// postconditions:	edges holds the SCALE_FREE edges
+	//
+	void generateScaleFree(vector<Graph::EdgeTriple> &edges);
+
+	// generateDense: generate helper
+	// keeps each ordered pair of distinct vertices as an edge with probability
+	// m_edgeCount / (m_size * (m_size - 1))
+	// preconditions:	none
+	// postconditions:	edges holds the DENSE edges
+	//
+	void generateDense(vector<Graph::EdgeTriple> &edges);
+
+	// addEdge
+	// appends the edge from index value source to index value dest with a 
+	// weight of at least minWeight times a uniformly drawn weight
+	// preconditions:	minWeight >= 1
+	// postconditions:	edges holds one more triple
+	//
+	void addEdge(vector<Graph::EdgeTriple> &edges, int source, int dest,
+		int minWeight = 1);
+
+	// nextRandom
+	// advances m_state and returns the next 64 random bits (SplitMix64)
+	// preconditions:	none
+	// postconditions:	m_state is advanced; returns the bits
+	//
+	unsigned long long nextRandom();
+
+	// nextInt
+	// returns an integer drawn uniformly from 0 through bound - 1
+	// preconditions:	bound >= 1
+	// postconditions:	returns the integer
+	//
+	int nextInt(int bound);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,207 @@
+// GraphLoader.cpp		Author: Sam Hoover
+// contains the definitions for the GraphLoader class.
+//
+// GraphLoader		Author: Sam Hoover
+//
+// Description:
+// A fast reader for graph files in the format outlined in HW3.pdf: the number
+// of vertices, one description line per vertex, then "source dest cost" 
+// triples ending with a triple whose source is 0. The whole file is mapped 
+// into memory (or, where mapping is unavailable, read in large blocks) and 
+// the integers are parsed by hand, so loading stays limited by the disk 
+// rather than by stream extraction.
+//
+// Functionality:
+// A GraphLoader is opened on a file name and then read front to back with 
+// readSize(int&), readLine(string&) and readEdge(int&, int&, int&), in the 
+// same order Graph::buildGraph(ifstream&) reads an ifstream. It is normally
+// passed to Graph::buildGraph(GraphLoader&), which reads it completely and
+// calls finish(). getStats() then reports the bytes parsed, edges read and 
+// time taken as a LoadStats, whose bytesPerSecond() and edgesPerSecond() show
+// whether loading is I/O-bound.
+//
+// Assumptions:
+// This class assumes the following:
+//		-the file is in the proper format, as outlined in the HW3.pdf
+//		-integers in the file fit in an int
+//
+#ifndef GRAPHLOADER_CPP
+#define GRAPHLOADER_CPP
+#include "GraphLoader.h"
+
+// LoadStats default constructor
+// creates a LoadStats representing no work
+// preconditions:	none
+// postconditions:	m_bytes = 0; m_edges = 0; m_seconds = 0
+//
+GraphLoader::LoadStats::LoadStats() : m_bytes(0), m_edges(0), m_seconds(0) {}
+
+
+// bytesPerSecond
+// returns the parsing throughput in bytes per second
+// preconditions:	none
+// postconditions:	returns m_bytes / m_seconds, or 0 if m_seconds = 0
+//
+double GraphLoader::LoadStats::bytesPerSecond() const {
+	return(m_seconds > 0 ? m_bytes / m_seconds : 0);
+}
+
+
+// edgesPerSecond
+// returns the parsing throughput in edges per second
+// preconditions:	none
+// postconditions:	returns m_edges / m_seconds, or 0 if m_seconds = 0
+//
+double GraphLoader::LoadStats::edgesPerSecond() const {
+	return(m_seconds > 0 ? m_edges / m_seconds : 0);
+}
+
+
+// constructor(string)
+// opens fileName and maps or reads its contents into memory
+// preconditions:	none
+// postconditions:	isOpen() is true if fileName could be read; the read
+//					position is the start of the file
+//
+GraphLoader::GraphLoader(const string &fileName) : 
+	m_start(chrono::steady_clock::now()), m_file(fileName), 
+	m_begin(m_file.getData()), m_position(m_begin), 
+	m_end(m_begin + m_file.getSize()), m_finished(false), m_edges(0), 
+	m_stop(m_start) {}
+
+
+// isOpen
+// returns true if the file could be opened and read
+// preconditions:	none
+// postconditions:	returns true if the file contents are available
+//
+bool GraphLoader::isOpen() const {
+	return(m_file.isOpen());
+}
+
+
+// readSize
+// reads the number of vertices and moves past the end of its line
+// preconditions:	the read position is at the start of the file
+// postconditions:	size is set and true is returned, or false is 
+//					returned if no integer could be read
+//
+bool GraphLoader::readSize(int &size) {
+	if(!readInt(size)) {
+		return(false);
+	}
+	// throw away the line ending, like infile.ignore() in text mode
+	if(m_position != m_end && *m_position == '\r') {
+		m_position++;
+	}
+	if(m_position != m_end) {
+		m_position++;
+	}
+	return(true);
+}
+
+
+// readLine
+// reads the rest of the current line, without its line ending
+// preconditions:	none
+// postconditions:	line is set and true is returned, or false is 
+//					returned at the end of the file
+//
+bool GraphLoader::readLine(string &line) {
+	if(m_position == m_end) {
+		line.clear();
+		return(false);
+	}
+	const char *start = m_position;
+	while(m_position != m_end && *m_position != '\n') {
+		m_position++;
+	}
+	const char *stop = m_position;
+	if(stop != start && *(stop - 1) == '\r') {
+		stop--;
+	}
+	line.assign(start, stop);
+	if(m_position != m_end) {
+		m_position++;
+	}
+	return(true);
+}
+
+
+// readEdge
+// reads the next "source dest cost" triple
+// preconditions:	readSize and one readLine per vertex have been called
+// postconditions:	source, dest and cost are set and true is returned, or
+//					false is returned at the terminating triple, at the end
+//					of the file or at a value that is not an integer
+//
+bool GraphLoader::readEdge(int &source, int &dest, int &cost) {
+	if(!readInt(source) || source == 0 || !readInt(dest) || !readInt(cost)) {
+		return(false);
+	}
+	m_edges++;
+	return(true);
+}
+
+
+// readInt
+// skips whitespace and parses an optionally signed decimal integer
+// preconditions:	none
+// postconditions:	returns true and sets value if an integer was read; 
+//					m_position is just past it
+//
+bool GraphLoader::readInt(int &value) {
+	const char *p = m_position;
+	while(p != m_end && (*p == ' ' || *p == '\t' || *p == '\n' || 
+		*p == '\r' || *p == '\v' || *p == '\f')) {
+		p++;
+	}
+	bool negative = false;
+	if(p != m_end && (*p == '-' || *p == '+')) {
+		negative = (*p == '-');
+		p++;
+	}
+	if(p == m_end || static_cast<unsigned>(*p - '0') > 9) {
+		m_position = p;
+		return(false);
+	}
+	int result = 0;
+	while(p != m_end && static_cast<unsigned>(*p - '0') <= 9) {
+		result = result * 10 + (*p - '0');
+		p++;
+	}
+	value = negative ? -result : result;
+	m_position = p;
+	return(true);
+}
+
+
+// finish
+// stops the clock reported by getStats()
+// preconditions:	none
+// postconditions:	getStats().m_seconds no longer changes
+//
+void GraphLoader::finish() {
+	if(!m_finished) {
+		m_stop = chrono::steady_clock::now();
+		m_finished = true;
+	}
+}
+
+
+// getStats
+// returns the bytes parsed, edges read and time taken so far
+// preconditions:	none
+// postconditions:	returns a LoadStats for the work done since opening
+//
+GraphLoader::LoadStats GraphLoader::getStats() const {
+	LoadStats stats;
+	stats.m_bytes = m_position - m_begin;
+	stats.m_edges = m_edges;
+	chrono::steady_clock::time_point stop = m_finished ? m_stop : 
+		chrono::steady_clock::now();
+	stats.m_seconds = chrono::duration<double>(stop - m_start).count();
+	return(stats);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+// GraphLoader.h		Author: Sam Hoover
+// contains the declarations for the GraphLoader class.
+//
+#ifndef GRAPHLOADER_H
+#define GRAPHLOADER_H
+#include <string>
+#include <chrono>
+#include "MappedFile.h"
+using namespace std;
+
+// GraphLoader		Author: Sam Hoover
+//
+// Description:
+// A fast reader for graph files in the format outlined in HW3.pdf: the number
+// of vertices, one description line per vertex, then "source dest cost" 
+// triples ending with a triple whose source is 0. The whole file is mapped 
+// into memory (or, where mapping is unavailable, read in large blocks) and 
+// the integers are parsed by hand, so loading stays limited by the disk 
+// rather than by stream extraction.
+//
+// Functionality:
+// A GraphLoader is opened on a file name and then read front to back with 
+// readSize(int&), readLine(string&) and readEdge(int&, int&, int&), in the 
+// same order Graph::buildGraph(ifstream&) reads an ifstream. It is normally
+// passed to Graph::buildGraph(GraphLoader&), which reads it completely and
+// calls finish(). getStats() then reports the bytes parsed, edges read and 
+// time taken as a LoadStats, whose bytesPerSecond() and edgesPerSecond() show
+// whether loading is I/O-bound.
+//
+// Assumptions:
+// This class assumes the following:
+//		-the file is in the proper format, as outlined in the HW3.pdf
+//		-integers in the file fit in an int
+//
+class GraphLoader {
+public:
+	// LoadStats
+	// the work done by a GraphLoader. m_bytes counts the bytes parsed, 
+	// m_edges the edge triples read (not counting the terminating triple), 
+	// and m_seconds the time from opening the file until finish() was called.
+	//
+	struct LoadStats {
+		// default constructor
+		// creates a LoadStats representing no work
+		// preconditions:	none
+		// postconditions:	m_bytes = 0; m_edges = 0; m_seconds = 0
+		//
+		LoadStats();
+
+		// bytesPerSecond
+		// returns the parsing throughput in bytes per second
+		// preconditions:	none
+		// postconditions:	returns m_bytes / m_seconds, or 0 if m_seconds = 0
+		//
+		double bytesPerSecond() const;
+
+		// edgesPerSecond
+		// returns the parsing throughput in edges per second
+		// preconditions:	none
+		// postconditions:	returns m_edges / m_seconds, or 0 if m_seconds = 0
+		//
+		double edgesPerSecond() const;
+
+		long long m_bytes;
+		long long m_edges;
+		double m_seconds;
+	};
+
+	// constructor(string)
+	// opens fileName and maps or reads its contents into memory
+	// preconditions:	none
+	// postconditions:	isOpen() is true if fileName could be read; the read
+	//					position is the start of the file
+	//
+	explicit GraphLoader(const string &fileName);
+
+	// isOpen
+	// returns true if the file could be opened and read
+	// preconditions:	none
+	// postconditions:	returns true if the file contents are available
+	//
+	bool isOpen() const;
+
+	// readSize
+	// reads the number of vertices and moves past the end of its line
+	// preconditions:	the read position is at the start of the file
+	// postconditions:	size is set and true is returned, or false is 
+	//					returned if no integer could be read
+	//
+	bool readSize(int &size);
+
+	// readLine
+	// reads the rest of the current line, without its line ending
+	// preconditions:	none
+	// postconditions:	line is set and true is returned, or false is 
+	//					returned at the end of the file
+	//
+	bool readLine(string &line);
+
+	// readEdge
+	// reads the next "source dest cost" triple
+	// preconditions:	readSize and one readLine per vertex have been called
+	// postconditions:	source, dest and cost are set and true is returned, or
+	//					false is returned at the terminating triple, at the end
+	//					of the file or at a value that is not an integer
+	//
+	bool readEdge(int &source, int &dest, int &cost);
+
+	// finish
+	// stops the clock reported by getStats()
+	// preconditions:	none
+	// postconditions:	getStats().m_seconds no longer changes
+	//
+	void finish();
+
+	// getStats
+	// returns the bytes parsed, edges read and time taken so far
+	// preconditions:	none
+	// postconditions:	returns a LoadStats for the work done since opening
+	//
+	LoadStats getStats() const;
+
+private:
+	GraphLoader(const GraphLoader &);
+	GraphLoader &operator=(const GraphLoader &);
+
+	chrono::steady_clock::time_point m_start;	// set before m_file is read
+	MappedFile m_file;
+	const char *m_begin;		// first byte of the file contents
+	const char *m_position;		// next byte to parse
+	const char *m_end;			// one past the last byte
+	bool m_finished;
+	long long m_edges;
+	chrono::steady_clock::time_point m_stop;
+
+	// readInt
+	// skips whitespace and parses an optionally signed decimal integer
+	// preconditions:	none
+	// postconditions:	returns true and sets value if an integer was read; 
+	//					m_position is just past it
+	//
+	bool readInt(int &value);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+// Heuristics.cpp		Author: Sam Hoover
+// contains the definitions for the A* search heuristics.
+//
+// Heuristics		Author: Sam Hoover
+//
+// Description:
+// Function objects that estimate the remaining distance from one location to
+// another for Graph::queryAStar. Each is called as heuristic(vertex, dest) 
+// with the GraphData of the vertex being reached and of the destination, and
+// returns a non-negative estimate.
+//
+// Note: <cmath> defines an INFINITY macro that collides with Graph::INFINITY,
+// so these are defined here, in a file that does not include Graph.h.
+//
+#ifndef HEURISTICS_CPP
+#define HEURISTICS_CPP
+#include <cmath>
+#include "Heuristics.h"
+
+// ZeroHeuristic estimate
+// returns 0
+// preconditions:	none
+// postconditions:	returns 0
+//
+double ZeroHeuristic::operator()(const GraphData &, const GraphData &) const {
+	return(0);
+}
+
+
+// EuclideanHeuristic constructor(double)
+// creates a EuclideanHeuristic with m_scale equal to scale
+// preconditions:	scale >= 0
+// postconditions:	m_scale = scale
+//
+EuclideanHeuristic::EuclideanHeuristic(double scale) : m_scale(scale) {}
+
+
+// EuclideanHeuristic estimate
+// returns m_scale times the straight-line distance from vertex to dest
+// preconditions:	none
+// postconditions:	returns the estimate, or 0 if either location has no
+//					coordinates
+//
+double EuclideanHeuristic::operator()(const GraphData &vertex, 
+	const GraphData &dest) const {
+	if(!vertex.hasCoordinates() || !dest.hasCoordinates()) {
+		return(0);
+	}
+	double dx = vertex.getX() - dest.getX();
+	double dy = vertex.getY() - dest.getY();
+	return(m_scale * sqrt(dx * dx + dy * dy));
+}
+
+
+// ManhattanHeuristic constructor(double)
+// creates a ManhattanHeuristic with m_scale equal to scale
+// preconditions:	scale >= 0
+// postconditions:	m_scale = scale
+//
+ManhattanHeuristic::ManhattanHeuristic(double scale) : m_scale(scale) {}
+
+
+// ManhattanHeuristic estimate
+// returns m_scale times the grid distance from vertex to dest
+// preconditions:	none
+// postconditions:	returns the estimate, or 0 if either location has no
+//					coordinates
+//
+double ManhattanHeuristic::operator()(const GraphData &vertex, 
+	const GraphData &dest) const {
+	if(!vertex.hasCoordinates() || !dest.hasCoordinates()) {
+		return(0);
+	}
+	return(m_scale * (fabs(vertex.getX() - dest.getX()) + 
+		fabs(vertex.getY() - dest.getY())));
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,85 @@
+// Heuristics.h		Author: Sam Hoover
+// contains the declarations for the A* search heuristics.
+//
+#ifndef HEURISTICS_H
+#define HEURISTICS_H
+#include "GraphData.h"
+
+// Heuristics		Author: Sam Hoover
+//
+// Description:
+// Function objects that estimate the remaining distance from one location to
+// another for Graph::queryAStar. Each is called as heuristic(vertex, dest) 
+// with the GraphData of the vertex being reached and of the destination, and
+// returns a non-negative estimate.
+//
+// Functionality:
+// The estimate is the geometric distance between the two locations' 
+// coordinates multiplied by m_scale. A heuristic is admissible, and A* then
+// returns the same distances as Dijkstra's Algorithm, when the estimate never
+// exceeds the true shortest distance; choose m_scale no larger than the 
+// smallest ratio of edge weight to coordinate distance in the graph. 
+// Locations without coordinates are estimated at 0, which is always 
+// admissible. Any other type with the same call signature can be passed to
+// queryAStar in place of these.
+//
+
+// ZeroHeuristic
+// estimates every distance as 0, making A* behave exactly like Dijkstra's
+// Algorithm
+//
+struct ZeroHeuristic {
+	// estimate
+	// returns 0
+	// preconditions:	none
+	// postconditions:	returns 0
+	//
+	double operator()(const GraphData &vertex, const GraphData &dest) const;
+};
+
+// EuclideanHeuristic
+// estimates the straight-line distance between two locations
+//
+struct EuclideanHeuristic {
+	// constructor(double)
+	// creates a EuclideanHeuristic with m_scale equal to scale
+	// preconditions:	scale >= 0
+	// postconditions:	m_scale = scale
+	//
+	explicit EuclideanHeuristic(double scale = 1.0);
+
+	// estimate
+	// returns m_scale times the straight-line distance from vertex to dest
+	// preconditions:	none
+	// postconditions:	returns the estimate, or 0 if either location has no
+	//					coordinates
+	//
+	double operator()(const GraphData &vertex, const GraphData &dest) const;
+
+	double m_scale;
+};
+
+// ManhattanHeuristic
+// estimates the grid (sum of axis differences) distance between two 
+// locations, for graphs whose edges only run along the axes
+//
+struct ManhattanHeuristic {
+	// constructor(double)
+	// creates a ManhattanHeuristic with m_scale equal to scale
+	// preconditions:	scale >= 0
+	// postconditions:	m_scale = scale
+	//
+	explicit ManhattanHeuristic(double scale = 1.0);
+
+	// estimate
+	// returns m_scale times the grid distance from vertex to dest
+	// preconditions:	none
+	// postconditions:	returns the estimate, or 0 if either location has no
+	//					coordinates
+	//
+	double operator()(const GraphData &vertex, const GraphData &dest) const;
+
+	double m_scale;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,164 @@
+// MappedFile.cpp		Author: Sam Hoover
+// contains the definitions for the MappedFile class.
+//
+// MappedFile		Author: Sam Hoover
+//
+// Description:
+// The read-only contents of a file, held in memory. Where the system 
+// supports it the file is memory-mapped, so its pages are loaded on first
+// use and shared with every other process mapping the same file; otherwise
+// it is read into a buffer in large blocks.
+//
+// Functionality:
+// A MappedFile is opened on a file name and its bytes are then available 
+// through getData() and getSize() until it is destroyed. isMapped() tells
+// which of the two strategies was used.
+//
+// Assumptions:
+// This class assumes the following:
+//		-the file is not modified while it is open
+//
+#ifndef MAPPEDFILE_CPP
+#define MAPPEDFILE_CPP
+#include "MappedFile.h"
+#include <cstdio>
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPEDFILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// size of the blocks read by readFile when the file cannot be mapped
+static const size_t BLOCK_SIZE = 1 << 20;
+
+
+// constructor(string)
+// maps or reads the contents of fileName into memory
+// preconditions:	none
+// postconditions:	isOpen() is true if fileName could be read
+//
+MappedFile::MappedFile(const string &fileName) : m_data(nullptr), m_size(0),
+	m_map(nullptr), m_open(false) {
+	m_open = mapFile(fileName) || readFile(fileName);
+}
+
+
+// destructor
+// unmaps or frees the file contents
+// preconditions:	none
+// postconditions:	no memory is held for the file
+//
+MappedFile::~MappedFile() {
+#ifdef MAPPEDFILE_MMAP
+	if(m_map != nullptr) {
+		munmap(m_map, m_size);
+		m_map = nullptr;
+	}
+#endif
+}
+
+
+// mapFile: constructor helper
+// maps fileName into memory
+// preconditions:	none
+// postconditions:	returns true and sets m_map, m_data and m_size if the
+//					file could be mapped
+//
+bool MappedFile::mapFile(const string &fileName) {
+#ifdef MAPPEDFILE_MMAP
+	int file = open(fileName.c_str(), O_RDONLY);
+	if(file < 0) {
+		return(false);
+	}
+	struct stat info;
+	if(fstat(file, &info) != 0 || info.st_size <= 0) {
+		close(file);
+		return(false);
+	}
+	size_t size = static_cast<size_t>(info.st_size);
+	void *map = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+	if(map == MAP_FAILED) {
+		return(false);
+	}
+	m_map = map;
+	m_data = static_cast<const char*>(map);
+	m_size = size;
+	return(true);
+#else
+	(void)fileName;
+	return(false);
+#endif
+}
+
+
+// readFile: constructor helper
+// reads fileName into m_buffer in large blocks
+// preconditions:	none
+// postconditions:	returns true and sets m_data and m_size if the file
+//					could be read
+//
+bool MappedFile::readFile(const string &fileName) {
+	FILE *file = fopen(fileName.c_str(), "rb");
+	if(file == nullptr) {
+		return(false);
+	}
+	size_t used = 0;
+	for(;;) {
+		m_buffer.resize(used + BLOCK_SIZE);
+		size_t count = fread(&m_buffer[used], 1, BLOCK_SIZE, file);
+		used += count;
+		if(count < BLOCK_SIZE) {
+			break;
+		}
+	}
+	fclose(file);
+	m_buffer.resize(used);
+	m_data = m_buffer.data();
+	m_size = used;
+	return(true);
+}
+
+
+// isOpen
+// returns true if the file could be opened and read
+// preconditions:	none
+// postconditions:	returns m_open
+//
+bool MappedFile::isOpen() const {
+	return(m_open);
+}
+
+
+// isMapped
+// returns true if the file contents are memory-mapped
+// preconditions:	none
+// postconditions:	returns true if m_map is not nullptr
+//
+bool MappedFile::isMapped() const {
+	return(m_map != nullptr);
+}
+
+
+// getData
+// returns the first byte of the file contents
+// preconditions:	none
+// postconditions:	returns m_data, which may be nullptr if getSize() = 0
+//
+const char *MappedFile::getData() const {
+	return(m_data);
+}
+
+
+// getSize
+// returns the number of bytes in the file
+// preconditions:	none
+// postconditions:	returns m_size
+//
+size_t MappedFile::getSize() const {
+	return(m_size);
+}
+
+#endif
\ No newline at end of file
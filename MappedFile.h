@@ -0,0 +1,99 @@
+// MappedFile.h		Author: Sam Hoover
+// contains the declarations for the MappedFile class.
+//
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+#include <string>
+#include <vector>
+#include <cstddef>
+using namespace std;
+
+// MappedFile		Author: Sam Hoover
+//
+// Description:
+// The read-only contents of a file, held in memory. Where the system 
+// supports it the file is memory-mapped, so its pages are loaded on first
+// use and shared with every other process mapping the same file; otherwise
+// it is read into a buffer in large blocks.
+//
+// Functionality:
+// A MappedFile is opened on a file name and its bytes are then available 
+// through getData() and getSize() until it is destroyed. isMapped() tells
+// which of the two strategies was used.
+//
+// Assumptions:
+// This class assumes the following:
+//		-the file is not modified while it is open
+//
+class MappedFile {
+public:
+	// constructor(string)
+	// maps or reads the contents of fileName into memory
+	// preconditions:	none
+	// postconditions:	isOpen() is true if fileName could be read
+	//
+	explicit MappedFile(const string &fileName);
+
+	// destructor
+	// unmaps or frees the file contents
+	// preconditions:	none
+	// postconditions:	no memory is held for the file
+	//
+	~MappedFile();
+
+	// isOpen
+	// returns true if the file could be opened and read
+	// preconditions:	none
+	// postconditions:	returns m_open
+	//
+	bool isOpen() const;
+
+	// isMapped
+	// returns true if the file contents are memory-mapped
+	// preconditions:	none
+	// postconditions:	returns true if m_map is not nullptr
+	//
+	bool isMapped() const;
+
+	// getData
+	// returns the first byte of the file contents
+	// preconditions:	none
+	// postconditions:	returns m_data, which may be nullptr if getSize() = 0
+	//
+	const char *getData() const;
+
+	// getSize
+	// returns the number of bytes in the file
+	// preconditions:	none
+	// postconditions:	returns m_size
+	//
+	size_t getSize() const;
+
+private:
+	MappedFile(const MappedFile &);
+	MappedFile &operator=(const MappedFile &);
+
+	const char *m_data;
+	size_t m_size;
+	void *m_map;			// mapped file, nullptr if m_buffer is used
+	vector<char> m_buffer;	// file contents when not mapped
+	bool m_open;
+
+	// mapFile: constructor helper
+	// maps fileName into memory
+	// preconditions:	none
+	// postconditions:	returns true and sets m_map, m_data and m_size if the
+	//					file could be mapped
+	//
+	bool mapFile(const string &fileName);
+
+	// readFile: constructor helper
+	// reads fileName into m_buffer in large blocks
+	// preconditions:	none
+	// postconditions:	returns true and sets m_data and m_size if the file
+	//					could be read
+	//
+	bool readFile(const string &fileName);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,262 @@
+// NodePool.h		Author: Sam Hoover
+// contains the declaration and definition of the NodePool class template.
+//
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+#include <new>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// NodePool		Author: Sam Hoover
+//
+// Description:
+// A per-owner allocator for many small objects of a single type, T. Objects
+// are carved out of large chunks of memory instead of being allocated one at
+// a time, and destroyed objects are kept on a free list for reuse. Each new
+// chunk is twice the size of the last, up to m_maxChunk objects, so building
+// n objects costs O(log n) allocations.
+//
+// Functionality:
+// create(args...) constructs a T from args in pooled memory and returns a
+// pointer to it. destroy(T*) runs the object's destructor and puts its memory
+// on the free list. release() returns every chunk to the system at once, in 
+// O(number of chunks), without visiting the objects; objects that need their
+// destructor run must be destroyed first. The destructor calls release().
+//
+// Assumptions:
+// This class assumes the following:
+//		-every pointer passed to destroy(T*) came from create on the same pool
+//		-no object from the pool is used after release()
+//
+template <typename T>
+class NodePool {
+public:
+	// constructor(int, int)
+	// creates an empty NodePool whose first chunk holds firstChunk objects and
+	// whose chunks never hold more than maxChunk objects
+	// preconditions:	0 < firstChunk <= maxChunk
+	// postconditions:	no chunks are allocated
+	//
+	explicit NodePool(int firstChunk = 64, int maxChunk = 65536);
+
+	// move constructor
+	// takes over every chunk and object of pool
+	// preconditions:	none
+	// postconditions:	this holds pool's chunks; pool holds none
+	//
+	NodePool(NodePool &&pool) noexcept;
+
+	// destructor
+	// returns every chunk to the system
+	// preconditions:	objects that need their destructor run were destroyed
+	// postconditions:	no chunks are allocated
+	//
+	~NodePool();
+
+	// create
+	// constructs a T from args in pooled memory
+	// preconditions:	T has a constructor taking args
+	// postconditions:	returns a pointer to the new object
+	//
+	template <typename... Args>
+	T *create(Args&&... args);
+
+	// destroy
+	// runs node's destructor and keeps its memory for the next create
+	// preconditions:	node came from create on this pool and was not destroyed
+	// postconditions:	node's memory is on the free list
+	//
+	void destroy(T *node);
+
+	// release
+	// returns every chunk to the system without visiting the objects in them
+	// preconditions:	objects that need their destructor run were destroyed
+	// postconditions:	no chunks are allocated; the next chunk holds 
+	//					firstChunk objects again
+	//
+	void release();
+
+	// swap
+	// exchanges the chunks and objects of this and pool
+	// preconditions:	none
+	// postconditions:	this holds pool's chunks and pool holds this's
+	//
+	void swap(NodePool &pool) noexcept;
+
+	// getChunkCount
+	// returns the number of chunks currently allocated
+	// preconditions:	none
+	// postconditions:	returns the size of m_chunks
+	//
+	int getChunkCount() const;
+
+private:
+	NodePool(const NodePool &);
+	NodePool &operator=(const NodePool &);
+
+	// Slot
+	// storage for one object, or a link in the free list once destroyed
+	//
+	union Slot {
+		Slot *m_next;
+		alignas(T) unsigned char m_storage[sizeof(T)];
+	};
+
+	vector<Slot*> m_chunks;
+	Slot *m_free;		// head of the free list
+	Slot *m_unused;		// first never-used slot in the newest chunk
+	Slot *m_end;		// one past the last slot in the newest chunk
+	int m_firstChunk;
+	int m_nextChunk;	// number of slots in the next chunk
+	int m_maxChunk;
+
+	// grow
+	// allocates a new chunk of m_nextChunk slots
+	// preconditions:	none
+	// postconditions:	m_unused and m_end span the new chunk; m_nextChunk is
+	//					doubled, up to m_maxChunk
+	//
+	void grow();
+};
+
+
+// constructor(int, int)
+// creates an empty NodePool whose first chunk holds firstChunk objects and
+// whose chunks never hold more than maxChunk objects
+// preconditions:	0 < firstChunk <= maxChunk
+// postconditions:	no chunks are allocated
+//
+template <typename T>
+NodePool<T>::NodePool(int firstChunk, int maxChunk) : m_free(nullptr), 
+	m_unused(nullptr), m_end(nullptr), m_firstChunk(firstChunk), 
+	m_nextChunk(firstChunk), m_maxChunk(maxChunk) {}
+
+
+// move constructor
+// takes over every chunk and object of pool
+// preconditions:	none
+// postconditions:	this holds pool's chunks; pool holds none
+//
+template <typename T>
+NodePool<T>::NodePool(NodePool &&pool) noexcept : m_free(nullptr), 
+	m_unused(nullptr), m_end(nullptr), m_firstChunk(pool.m_firstChunk), 
+	m_nextChunk(pool.m_firstChunk), m_maxChunk(pool.m_maxChunk) {
+	swap(pool);
+}
+
+
+// destructor
+// returns every chunk to the system
+// preconditions:	objects that need their destructor run were destroyed
+// postconditions:	no chunks are allocated
+//
+template <typename T>
+NodePool<T>::~NodePool() {
+	release();
+}
+
+
+// create
+// constructs a T from args in pooled memory
+// preconditions:	T has a constructor taking args
+// postconditions:	returns a pointer to the new object
+//
+template <typename T>
+template <typename... Args>
+T *NodePool<T>::create(Args&&... args) {
+	Slot *slot = m_free;
+	if(slot != nullptr) {
+		m_free = slot->m_next;
+	} else {
+		if(m_unused == m_end) {
+			grow();
+		}
+		slot = m_unused++;
+	}
+	return(new (slot->m_storage) T(std::forward<Args>(args)...));
+}
+
+
+// destroy
+// runs node's destructor and keeps its memory for the next create
+// preconditions:	node came from create on this pool and was not destroyed
+// postconditions:	node's memory is on the free list
+//
+template <typename T>
+void NodePool<T>::destroy(T *node) {
+	if(node == nullptr) {
+		return;
+	}
+	node->~T();
+	Slot *slot = reinterpret_cast<Slot*>(node);
+	slot->m_next = m_free;
+	m_free = slot;
+}
+
+
+// release
+// returns every chunk to the system without visiting the objects in them
+// preconditions:	objects that need their destructor run were destroyed
+// postconditions:	no chunks are allocated; the next chunk holds 
+//					firstChunk objects again
+//
+template <typename T>
+void NodePool<T>::release() {
+	for(size_t i = 0; i < m_chunks.size(); i++) {
+		::operator delete(m_chunks[i]);
+	}
+	m_chunks.clear();
+	m_free = nullptr;
+	m_unused = nullptr;
+	m_end = nullptr;
+	m_nextChunk = m_firstChunk;
+}
+
+
+// swap
+// exchanges the chunks and objects of this and pool
+// preconditions:	none
+// postconditions:	this holds pool's chunks and pool holds this's
+//
+template <typename T>
+void NodePool<T>::swap(NodePool &pool) noexcept {
+	m_chunks.swap(pool.m_chunks);
+	std::swap(m_free, pool.m_free);
+	std::swap(m_unused, pool.m_unused);
+	std::swap(m_end, pool.m_end);
+	std::swap(m_firstChunk, pool.m_firstChunk);
+	std::swap(m_nextChunk, pool.m_nextChunk);
+	std::swap(m_maxChunk, pool.m_maxChunk);
+}
+
+
+// getChunkCount
+// returns the number of chunks currently allocated
+// preconditions:	none
+// postconditions:	returns the size of m_chunks
+//
+template <typename T>
+int NodePool<T>::getChunkCount() const {
+	return(static_cast<int>(m_chunks.size()));
+}
+
+
+// grow
+// allocates a new chunk of m_nextChunk slots
+// preconditions:	none
+// postconditions:	m_unused and m_end span the new chunk; m_nextChunk is
+//					doubled, up to m_maxChunk
+//
+template <typename T>
+void NodePool<T>::grow() {
+	Slot *chunk = static_cast<Slot*>(::operator new(sizeof(Slot) * m_nextChunk));
+	m_chunks.push_back(chunk);
+	m_unused = chunk;
+	m_end = chunk + m_nextChunk;
+	if(m_nextChunk < m_maxChunk) {
+		m_nextChunk = (m_nextChunk > m_maxChunk / 2) ? m_maxChunk : m_nextChunk * 2;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,190 @@
+// PriorityQueues.h		Author: Sam Hoover
+// contains the declaration and definition of the BucketQueue class.
+//
+#ifndef PRIORITYQUEUES_H
+#define PRIORITYQUEUES_H
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// BucketQueue		Author: Sam Hoover
+//
+// Description:
+// A monotone priority queue of (distance, vertex index) pairs for graphs
+// whose edge weights are small integers, as used by Dial's algorithm. Each
+// distance has a bucket holding the vertices pushed at that distance. Since
+// a Dijkstra search never pushes a distance more than the largest edge
+// weight past the one it last popped, m_buckets only needs maxWeight + 1
+// buckets, reused in a circle.
+//
+// Functionality:
+// A BucketQueue offers the same push, top, pop and empty operations as
+// Graph's MinHeap, so a search written as a template over its queue can
+// use either one without virtual calls. push and pop cost O(1), plus one
+// step for every empty distance pop passes over. Entries come out in the
+// same order MinHeap gives them: by distance, and by vertex index among
+// equal distances, so both queues make a search visit vertices in the same
+// order. m_dist only moves forward, to the next bucket holding entries, 
+// when top() or pop() needs it to; that bucket is then sorted from highest
+// to lowest vertex index so the lowest is at its back, and kept sorted 
+// while entries are pushed into it.
+//
+// Assumptions:
+// This class assumes the following:
+//		-pushed distances are not negative, not less than the distance of the
+//		 last entry popped and no more than maxWeight past it
+//
+class BucketQueue {
+public:
+	// constructor(int)
+	// creates an empty BucketQueue for edges no heavier than maxWeight
+	// preconditions:	maxWeight >= 0
+	// postconditions:	m_buckets holds maxWeight + 1 empty buckets
+	//
+	explicit BucketQueue(int maxWeight);
+
+	// empty
+	// returns true if the queue holds no entries, else false
+	// preconditions:	none
+	// postconditions:	returns m_count == 0
+	//
+	bool empty() const;
+
+	// top
+	// returns the entry with the lowest distance, and the lowest vertex
+	// index among those
+	// preconditions:	the queue is not empty
+	// postconditions:	m_dist is the lowest distance held; returns (m_dist, 
+	//					lowest vertex index at m_dist)
+	//
+	pair<int, int> top();
+
+	// push
+	// adds entry, a (distance, vertex index) pair, to the queue
+	// preconditions:	entry satisfies the class assumptions
+	// postconditions:	entry is in the queue
+	//
+	void push(const pair<int, int> &entry);
+
+	// pop
+	// removes the entry top() returns
+	// preconditions:	the queue is not empty
+	// postconditions:	the entry is removed
+	//
+	void pop();
+
+private:
+	vector<vector<int> > m_buckets;	// vertices at distance d are in d % size
+	int m_dist;			// lowest distance that can still be held
+	int m_sortedDist;	// distance whose bucket is sorted, -1 for none
+	int m_count;		// entries in every bucket
+
+	// advance
+	// moves m_dist forward to the lowest distance held and sorts its bucket
+	// preconditions:	the queue is not empty
+	// postconditions:	bucket(m_dist) is not empty and is sorted; 
+	//					m_sortedDist = m_dist
+	//
+	void advance();
+
+	// bucket
+	// returns the bucket holding the vertices at distance dist
+	// preconditions:	dist >= 0
+	// postconditions:	returns m_buckets[dist % m_buckets.size()]
+	//
+	vector<int> &bucket(int dist);
+};
+
+// constructor(int)
+// creates an empty BucketQueue for edges no heavier than maxWeight
+// preconditions:	maxWeight >= 0
+// postconditions:	m_buckets holds maxWeight + 1 empty buckets
+//
+inline BucketQueue::BucketQueue(int maxWeight) :
+	m_buckets(static_cast<size_t>(maxWeight) + 1), m_dist(0), 
+	m_sortedDist(-1), m_count(0) {}
+
+
+// empty
+// returns true if the queue holds no entries, else false
+// preconditions:	none
+// postconditions:	returns m_count == 0
+//
+inline bool BucketQueue::empty() const {
+	return(m_count == 0);
+}
+
+
+// top
+// returns the entry with the lowest distance, and the lowest vertex
+// index among those
+// preconditions:	the queue is not empty
+// postconditions:	m_dist is the lowest distance held; returns (m_dist, 
+//					lowest vertex index at m_dist)
+//
+inline pair<int, int> BucketQueue::top() {
+	advance();
+	return(make_pair(m_dist, bucket(m_dist).back()));
+}
+
+
+// push
+// adds entry, a (distance, vertex index) pair, to the queue
+// preconditions:	entry satisfies the class assumptions
+// postconditions:	entry is in the queue
+//
+inline void BucketQueue::push(const pair<int, int> &entry) {
+	vector<int> &into = bucket(entry.first);
+	if(entry.first == m_sortedDist) {
+		// only an edge of weight 0 pushes into the bucket being popped
+		into.insert(upper_bound(into.begin(), into.end(), entry.second,
+			greater<int>()), entry.second);
+	} else {
+		into.push_back(entry.second);
+	}
+	m_count++;
+}
+
+
+// pop
+// removes the entry top() returns
+// preconditions:	the queue is not empty
+// postconditions:	the entry is removed
+//
+inline void BucketQueue::pop() {
+	advance();
+	bucket(m_dist).pop_back();
+	m_count--;
+}
+
+
+// advance
+// moves m_dist forward to the lowest distance held and sorts its bucket
+// preconditions:	the queue is not empty
+// postconditions:	bucket(m_dist) is not empty and is sorted; 
+//					m_sortedDist = m_dist
+//
+inline void BucketQueue::advance() {
+	while(bucket(m_dist).empty()) {
+		m_dist++;
+	}
+	if(m_sortedDist != m_dist) {
+		vector<int> &next = bucket(m_dist);
+		sort(next.begin(), next.end(), greater<int>());
+		m_sortedDist = m_dist;
+	}
+}
+
+
+// bucket
+// returns the bucket holding the vertices at distance dist
+// preconditions:	dist >= 0
+// postconditions:	returns m_buckets[dist % m_buckets.size()]
+//
+inline vector<int> &BucketQueue::bucket(int dist) {
+	return(m_buckets[dist % m_buckets.size()]);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,149 @@
+// ThreadPool.cpp		Author: Sam Hoover
+// contains the definitions for the ThreadPool class.
+//
+// ThreadPool		Author: Sam Hoover
+//
+// Description:
+// A fixed-size pool of worker threads that run parallel loops. Indices of a
+// loop are handed out one at a time from a shared atomic counter, so a thread
+// that finishes a cheap index immediately takes the next one and uneven work
+// (such as Dijkstra runs from different sources) stays balanced.
+//
+// Functionality:
+// A ThreadPool is created with the number of threads that should run each
+// loop, including the calling thread. parallelFor(int, task) calls 
+// task(index, thread) once for every index in [0, count) and returns when all
+// of them have finished. thread is in [0, getThreadCount()) and identifies 
+// the thread running the task, so callers can keep per-thread scratch state.
+// The workers sleep between loops and are joined by the destructor.
+//
+// Assumptions:
+// This class assumes the following:
+//		-tasks do not throw exceptions
+//		-parallelFor(int, task) is not called from inside a running task
+//
+#ifndef THREADPOOL_CPP
+#define THREADPOOL_CPP
+#include "ThreadPool.h"
+
+// constructor(int)
+// creates a ThreadPool that runs loops on threadCount threads, the calling
+// thread included. A threadCount less than 1 is treated as 1.
+// preconditions:	none
+// postconditions:	threadCount - 1 worker threads are started
+//
+ThreadPool::ThreadPool(int threadCount) : m_task(nullptr), m_count(0), 
+	m_next(0), m_busy(0), m_generation(0), m_stop(false) {
+	for(int i = 1; i < threadCount; i++) {
+		m_workers.push_back(thread(&ThreadPool::workerLoop, this, i));
+	}
+}
+
+
+// destructor
+// stops and joins all worker threads
+// preconditions:	no loop is running
+// postconditions:	all worker threads have exited
+//
+ThreadPool::~ThreadPool() {
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+	for(size_t i = 0; i < m_workers.size(); i++) {
+		m_workers[i].join();
+	}
+}
+
+
+// getThreadCount
+// returns the number of threads that run each loop
+// preconditions:	none
+// postconditions:	returns the number of workers plus one
+//
+int ThreadPool::getThreadCount() const {
+	return(static_cast<int>(m_workers.size()) + 1);
+}
+
+
+// parallelFor
+// calls task(index, thread) for every index in [0, count), spreading the
+// indices across the pool's threads
+// preconditions:	task must be safe to call concurrently for different
+//					indices
+// postconditions:	task has returned for every index in [0, count)
+//
+void ThreadPool::parallelFor(int count, const function<void(int, int)> &task) {
+	if(count <= 0) {
+		return;
+	}
+
+	if(m_workers.empty() || count == 1) {
+		for(int i = 0; i < count; i++) {
+			task(i, 0);
+		}
+		return;
+	}
+
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_task = &task;
+		m_count = count;
+		m_next = 0;
+		m_busy = static_cast<int>(m_workers.size());
+		m_generation++;
+	}
+	m_wake.notify_all();
+
+	runIndices(0);
+
+	unique_lock<mutex> lock(m_mutex);
+	while(m_busy > 0) {
+		m_done.wait(lock);
+	}
+	m_task = nullptr;
+}
+
+
+// workerLoop
+// waits for loops to start and runs their indices on thread
+// preconditions:	thread is in [1, getThreadCount())
+// postconditions:	returns once m_stop is set
+//
+void ThreadPool::workerLoop(int thread) {
+	unsigned long seen = 0;
+	unique_lock<mutex> lock(m_mutex);
+	for(;;) {
+		while(!m_stop && m_generation == seen) {
+			m_wake.wait(lock);
+		}
+		if(m_stop) {
+			return;
+		}
+		seen = m_generation;
+
+		lock.unlock();
+		runIndices(thread);
+		lock.lock();
+
+		m_busy--;
+		if(m_busy == 0) {
+			m_done.notify_one();
+		}
+	}
+}
+
+
+// runIndices
+// claims and runs indices of the current loop until none are left
+// preconditions:	m_task is set for the current loop
+// postconditions:	every index has been claimed by some thread
+//
+void ThreadPool::runIndices(int thread) {
+	for(int i = m_next.fetch_add(1); i < m_count; i = m_next.fetch_add(1)) {
+		(*m_task)(i, thread);
+	}
+}
+
+#endif
\ No newline at end of file
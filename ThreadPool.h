@@ -0,0 +1,98 @@
+// ThreadPool.h		Author: Sam Hoover
+// contains the declarations for the ThreadPool class.
+//
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// ThreadPool		Author: Sam Hoover
+//
+// Description:
+// A fixed-size pool of worker threads that run parallel loops. Indices of a
+// loop are handed out one at a time from a shared atomic counter, so a thread
+// that finishes a cheap index immediately takes the next one and uneven work
+// (such as Dijkstra runs from different sources) stays balanced.
+//
+// Functionality:
+// A ThreadPool is created with the number of threads that should run each
+// loop, including the calling thread. parallelFor(int, task) calls 
+// task(index, thread) once for every index in [0, count) and returns when all
+// of them have finished. thread is in [0, getThreadCount()) and identifies 
+// the thread running the task, so callers can keep per-thread scratch state.
+// The workers sleep between loops and are joined by the destructor.
+//
+// Assumptions:
+// This class assumes the following:
+//		-tasks do not throw exceptions
+//		-parallelFor(int, task) is not called from inside a running task
+//
+class ThreadPool {
+public:
+	// constructor(int)
+	// creates a ThreadPool that runs loops on threadCount threads, the calling
+	// thread included. A threadCount less than 1 is treated as 1.
+	// preconditions:	none
+	// postconditions:	threadCount - 1 worker threads are started
+	//
+	explicit ThreadPool(int threadCount);
+
+	// destructor
+	// stops and joins all worker threads
+	// preconditions:	no loop is running
+	// postconditions:	all worker threads have exited
+	//
+	~ThreadPool();
+
+	// getThreadCount
+	// returns the number of threads that run each loop
+	// preconditions:	none
+	// postconditions:	returns the number of workers plus one
+	//
+	int getThreadCount() const;
+
+	// parallelFor
+	// calls task(index, thread) for every index in [0, count), spreading the
+	// indices across the pool's threads
+	// preconditions:	task must be safe to call concurrently for different
+	//					indices
+	// postconditions:	task has returned for every index in [0, count)
+	//
+	void parallelFor(int count, const function<void(int, int)> &task);
+
+private:
+	ThreadPool(const ThreadPool &);
+	ThreadPool &operator=(const ThreadPool &);
+
+	vector<thread> m_workers;
+	mutex m_mutex;
+	condition_variable m_wake;	// signals workers that a loop started
+	condition_variable m_done;	// signals the caller that workers finished
+	const function<void(int, int)> *m_task;
+	int m_count;
+	atomic<int> m_next;
+	int m_busy;					// workers still running the current loop
+	unsigned long m_generation;	// incremented once per loop
+	bool m_stop;
+
+	// workerLoop
+	// waits for loops to start and runs their indices on thread
+	// preconditions:	thread is in [1, getThreadCount())
+	// postconditions:	returns once m_stop is set
+	//
+	void workerLoop(int thread);
+
+	// runIndices
+	// claims and runs indices of the current loop until none are left
+	// preconditions:	m_task is set for the current loop
+	// postconditions:	every index has been claimed by some thread
+	//
+	void runIndices(int thread);
+};
+
+#endif
\ No newline at end of file